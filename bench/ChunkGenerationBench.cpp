@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "util/ThreadPool.hpp"
+#include "world/World.hpp"
+#include "world/surface/BlockySurfaceGenerator.hpp"
+#include "world/volume/PerlinNoiseGenerator.hpp"
+
+using namespace explo;
+
+namespace
+{
+    /// Spread over the terrain (the noise seed is fixed by PerlinNoiseGenerator), so that the timings average flat and hilly chunks.
+    glm::ivec3 const k_chunk_positions[]{{0, 0, 0}, {-3, 0, 5}, {7, 0, -2}, {12, 0, 12}, {-9, 0, -14}, {25, 0, -31}, {-40, 0, 18}, {3, 0, 60}};
+
+    /// The generators and the world the chunks are created in (no chunk is loaded within it).
+    struct GenerationContext
+    {
+        PerlinNoiseGenerator m_volume_generator{};
+        BlockySurfaceGenerator m_surface_generator{};
+        ThreadPool m_thread_pool{1};
+        World m_world{m_volume_generator, m_surface_generator, m_thread_pool};
+    };
+}  // namespace
+
+static void BM_PerlinNoiseGenerator_GenerateVolume(benchmark::State &state)
+{
+    VolumeStorageType volume_storage_type = VolumeStorageType(state.range(0));
+
+    GenerationContext context{};
+
+    for (auto _ : state)
+    {
+        for (glm::ivec3 const &chunk_pos : k_chunk_positions)
+        {
+            Chunk chunk(context.m_world, chunk_pos, volume_storage_type);
+            context.m_volume_generator.generate_volume(chunk);
+            benchmark::DoNotOptimize(chunk.get_volume().get_byte_size());
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(std::size(k_chunk_positions)));
+}
+BENCHMARK(BM_PerlinNoiseGenerator_GenerateVolume)
+    ->ArgName("storage")
+    ->Arg(int(VolumeStorageType::Dense))
+    ->Arg(int(VolumeStorageType::Octree))
+    ->Arg(int(VolumeStorageType::Palette))
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_BlockySurfaceGenerator_Generate(benchmark::State &state)
+{
+    VolumeStorageType volume_storage_type = VolumeStorageType(state.range(0));
+
+    GenerationContext context{};
+
+    // The volumes and the borders are generated once, only the surface generation is timed
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::vector<ChunkBorders> borders;
+    for (glm::ivec3 const &chunk_pos : k_chunk_positions)
+    {
+        std::unique_ptr<Chunk> &chunk = chunks.emplace_back(std::make_unique<Chunk>(context.m_world, chunk_pos, volume_storage_type));
+        context.m_volume_generator.generate_volume(*chunk);
+
+        ChunkBorders &chunk_borders = borders.emplace_back();
+        for (uint32_t face = 0; face < BlockFace_Count; face++)
+        {
+            Chunk neighbour(context.m_world, chunk_pos + ChunkBorders::get_face_normal(BlockFace(face)), VolumeStorageType::Dense);
+            context.m_volume_generator.generate_volume(neighbour);
+            chunk_borders.set_neighbour(BlockFace(face), neighbour);
+        }
+    }
+
+    size_t vertex_count = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < chunks.size(); i++)
+        {
+            Surface surface{};
+            SurfaceWriter surface_writer(surface);
+            context.m_surface_generator.generate(*chunks[i], borders[i], surface_writer);
+
+            vertex_count += surface.m_vertices.size();
+            benchmark::DoNotOptimize(surface.m_vertices.data());
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(chunks.size()));
+    state.counters["vertices/chunk"] = benchmark::Counter(double(vertex_count) / double(state.iterations() * chunks.size()));
+}
+BENCHMARK(BM_BlockySurfaceGenerator_Generate)
+    ->ArgName("storage")
+    ->Arg(int(VolumeStorageType::Dense))
+    ->Arg(int(VolumeStorageType::Octree))
+    ->Arg(int(VolumeStorageType::Palette))
+    ->Unit(benchmark::kMillisecond);
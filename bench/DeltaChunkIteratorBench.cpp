@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+
+#include "world/DeltaChunkIterator.hpp"
+
+using namespace explo;
+
+namespace
+{
+    glm::ivec3 get_render_distance(benchmark::State const &state)
+    {
+        return glm::ivec3(int(state.range(0)), 0, int(state.range(0)));
+    }
+}  // namespace
+
+/// A step of one chunk along x: one slab enters the world view.
+static void BM_DeltaChunkIterator_Step(benchmark::State &state)
+{
+    glm::ivec3 render_distance = get_render_distance(state);
+
+    int64_t chunk_count = 0;
+    for (auto _ : state)
+    {
+        DeltaChunkIterator iterator(
+            glm::ivec3(0),
+            glm::ivec3(1, 0, 0),
+            render_distance,
+            [&chunk_count](glm::ivec3 const &chunk_pos)
+            {
+                benchmark::DoNotOptimize(chunk_pos);
+                chunk_count++;
+            }
+        );
+        iterator.iterate();
+    }
+
+    state.SetItemsProcessed(chunk_count);
+}
+BENCHMARK(BM_DeltaChunkIterator_Step)->ArgName("render_distance")->Arg(8)->Arg(20);
+
+/// A diagonal step along x and z: two slabs (partially overlapping the old world view) enter it.
+static void BM_DeltaChunkIterator_DiagonalStep(benchmark::State &state)
+{
+    glm::ivec3 render_distance = get_render_distance(state);
+
+    int64_t chunk_count = 0;
+    for (auto _ : state)
+    {
+        DeltaChunkIterator iterator(
+            glm::ivec3(0),
+            glm::ivec3(1, 0, -1),
+            render_distance,
+            [&chunk_count](glm::ivec3 const &chunk_pos)
+            {
+                benchmark::DoNotOptimize(chunk_pos);
+                chunk_count++;
+            }
+        );
+        iterator.iterate();
+    }
+
+    state.SetItemsProcessed(chunk_count);
+}
+BENCHMARK(BM_DeltaChunkIterator_DiagonalStep)->ArgName("render_distance")->Arg(8)->Arg(20);
+
+/// The whole world view is iterated (the spawn, or a teleport).
+static void BM_DeltaChunkIterator_Spawn(benchmark::State &state)
+{
+    glm::ivec3 render_distance = get_render_distance(state);
+
+    int64_t chunk_count = 0;
+    for (auto _ : state)
+    {
+        DeltaChunkIterator iterator(
+            glm::ivec3(render_distance * 2 + 1),
+            glm::ivec3(0),
+            render_distance,
+            [&chunk_count](glm::ivec3 const &chunk_pos)
+            {
+                benchmark::DoNotOptimize(chunk_pos);
+                chunk_count++;
+            }
+        );
+        iterator.iterate();
+    }
+
+    state.SetItemsProcessed(chunk_count);
+}
+BENCHMARK(BM_DeltaChunkIterator_Spawn)->ArgName("render_distance")->Arg(8)->Arg(20);
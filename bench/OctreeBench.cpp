@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <random>
+#include <vector>
+
+#include "world/volume/Octree.hpp"
+
+using namespace explo;
+
+namespace
+{
+    constexpr uint32_t k_seed = 42;
+    constexpr uint32_t k_depth = 8;  // The octree covering a chunk (16x256x16 blocks)
+    constexpr size_t k_voxel_count = 16 * 256 * 16;
+
+    /// The morton codes of the chunk voxels, in x, y, z order.
+    std::vector<uint32_t> get_chunk_morton_codes()
+    {
+        std::vector<uint32_t> morton_codes;
+        morton_codes.reserve(k_voxel_count);
+
+        glm::ivec3 pos{};
+        for (pos.x = 0; pos.x < 16; pos.x++)
+        {
+            for (pos.y = 0; pos.y < 256; pos.y++)
+            {
+                for (pos.z = 0; pos.z < 16; pos.z++) morton_codes.push_back(Octree::to_morton_code(pos));
+            }
+        }
+
+        return morton_codes;
+    }
+
+    /// The morton codes of the chunk voxels in a fixed random order.
+    std::vector<uint32_t> get_shuffled_morton_codes()
+    {
+        std::vector<uint32_t> morton_codes = get_chunk_morton_codes();
+        std::shuffle(morton_codes.begin(), morton_codes.end(), std::mt19937(k_seed));
+        return morton_codes;
+    }
+
+    /// A chunk-like octree: stone up to y = 64, then a noisy layer of a few block types up to y = 80.
+    Octree create_terrain_octree(Octree::Layout layout)
+    {
+        Octree octree(k_depth, layout);
+        octree.fill_voxels(glm::ivec3(0), glm::ivec3(16, 64, 16), 3);
+
+        std::mt19937 random(k_seed);
+        glm::ivec3 pos{};
+        for (pos.x = 0; pos.x < 16; pos.x++)
+        {
+            for (pos.y = 64; pos.y < 80; pos.y++)
+            {
+                for (pos.z = 0; pos.z < 16; pos.z++) octree.set_voxel_at(Octree::to_morton_code(pos), random() % 4);
+            }
+        }
+        return octree;
+    }
+}  // namespace
+
+static void BM_Octree_SetVoxel(benchmark::State &state)
+{
+    Octree::Layout layout = Octree::Layout(state.range(0));
+    bool merge = state.range(1) != 0;
+
+    std::vector<uint32_t> morton_codes = get_shuffled_morton_codes();
+    std::mt19937 random(k_seed);
+
+    for (auto _ : state)
+    {
+        Octree octree(k_depth, layout);
+        for (uint32_t morton_code : morton_codes) octree.set_voxel_at(morton_code, random() % 4, merge);
+        benchmark::DoNotOptimize(octree.data());
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(morton_codes.size()));
+}
+BENCHMARK(BM_Octree_SetVoxel)
+    ->ArgNames({"layout", "merge"})
+    ->Args({int(Octree::Layout::Linear), 0})
+    ->Args({int(Octree::Layout::Packed), 0})
+    ->Args({int(Octree::Layout::Linear), 1})
+    ->Args({int(Octree::Layout::Packed), 1});
+
+static void BM_Octree_GetVoxel(benchmark::State &state)
+{
+    Octree octree = create_terrain_octree(Octree::Layout(state.range(0)));
+    std::vector<uint32_t> morton_codes = get_shuffled_morton_codes();
+
+    for (auto _ : state)
+    {
+        uint32_t result = 0;
+        for (uint32_t morton_code : morton_codes) result += octree.get_voxel_at(morton_code);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(morton_codes.size()));
+}
+BENCHMARK(BM_Octree_GetVoxel)->ArgName("layout")->Arg(int(Octree::Layout::Linear))->Arg(int(Octree::Layout::Packed));
+
+static void BM_Octree_Leaves(benchmark::State &state)
+{
+    Octree octree = create_terrain_octree(Octree::Layout(state.range(0)));
+
+    for (auto _ : state)
+    {
+        uint32_t result = 0;
+        octree.for_each_leaf(
+            [&result](Octree::Leaf const &leaf)
+            {
+                result += leaf.m_value;
+            }
+        );
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Octree_Leaves)->ArgName("layout")->Arg(int(Octree::Layout::Linear))->Arg(int(Octree::Layout::Packed));
+
+static void BM_Octree_ToMortonCode(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        uint32_t result = 0;
+        glm::ivec3 pos{};
+        for (pos.x = 0; pos.x < 16; pos.x++)
+        {
+            for (pos.y = 0; pos.y < 256; pos.y++)
+            {
+                for (pos.z = 0; pos.z < 16; pos.z++) result ^= Octree::to_morton_code(pos);
+            }
+        }
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(k_voxel_count));
+}
+BENCHMARK(BM_Octree_ToMortonCode);
+
+static void BM_Octree_ToVoxelPosition(benchmark::State &state)
+{
+    std::vector<uint32_t> morton_codes = get_chunk_morton_codes();
+
+    for (auto _ : state)
+    {
+        glm::ivec3 result(0);
+        for (uint32_t morton_code : morton_codes) result += Octree::to_voxel_position(morton_code);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(morton_codes.size()));
+}
+BENCHMARK(BM_Octree_ToVoxelPosition);
@@ -0,0 +1,111 @@
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "util/JobToken.hpp"
+#include "util/ThreadPool.hpp"
+
+using namespace explo;
+
+namespace
+{
+    constexpr size_t k_job_count = 10000;
+
+    void wait_for(std::atomic<size_t> const &counter, size_t value)
+    {
+        while (counter.load() < value) std::this_thread::yield();
+    }
+}  // namespace
+
+/// Empty jobs enqueued from outside of the pool (the injection queue), measures the scheduling overhead.
+static void BM_ThreadPool_InjectedJobs(benchmark::State &state)
+{
+    ThreadPool thread_pool(size_t(state.range(0)));
+
+    for (auto _ : state)
+    {
+        std::atomic<size_t> run_count = 0;
+        for (size_t i = 0; i < k_job_count; i++)
+        {
+            thread_pool.enqueue_job(
+                [&run_count]()
+                {
+                    run_count++;
+                }
+            );
+        }
+        wait_for(run_count, k_job_count);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(k_job_count));
+}
+BENCHMARK(BM_ThreadPool_InjectedJobs)->ArgName("threads")->Arg(1)->Arg(4)->UseRealTime();
+
+/// Empty jobs enqueued by the workers on their own deques (and stolen by the others).
+static void BM_ThreadPool_WorkerJobs(benchmark::State &state)
+{
+    size_t const k_fan_out = 100;
+
+    ThreadPool thread_pool(size_t(state.range(0)));
+
+    for (auto _ : state)
+    {
+        std::atomic<size_t> run_count = 0;
+        for (size_t i = 0; i < k_job_count / k_fan_out; i++)
+        {
+            thread_pool.enqueue_job(
+                [&thread_pool, &run_count, k_fan_out]()
+                {
+                    for (size_t j = 0; j < k_fan_out; j++)
+                    {
+                        thread_pool.enqueue_job(
+                            [&run_count]()
+                            {
+                                run_count++;
+                            }
+                        );
+                    }
+                }
+            );
+        }
+        wait_for(run_count, k_job_count);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(k_job_count));
+}
+BENCHMARK(BM_ThreadPool_WorkerJobs)->ArgName("threads")->Arg(1)->Arg(4)->UseRealTime();
+
+/// Empty jobs enqueued with a token, as the chunk generation jobs (the priority queue).
+static void BM_ThreadPool_PrioritizedJobs(benchmark::State &state)
+{
+    ThreadPool thread_pool(size_t(state.range(0)));
+
+    std::vector<std::shared_ptr<JobToken>> tokens;
+    for (size_t i = 0; i < 64; i++)
+    {
+        std::shared_ptr<JobToken> token = std::make_shared<JobToken>();
+        token->set_priority(float(i));
+        tokens.push_back(token);
+    }
+
+    for (auto _ : state)
+    {
+        std::atomic<size_t> run_count = 0;
+        for (size_t i = 0; i < k_job_count; i++)
+        {
+            thread_pool.enqueue_job(
+                [&run_count]()
+                {
+                    run_count++;
+                },
+                tokens[i % tokens.size()]
+            );
+        }
+        wait_for(run_count, k_job_count);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(k_job_count));
+}
+BENCHMARK(BM_ThreadPool_PrioritizedJobs)->ArgName("threads")->Arg(1)->Arg(4)->UseRealTime();
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "util/VirtualAllocator.hpp"
+
+using namespace explo;
+
+namespace
+{
+    constexpr uint32_t k_seed = 42;
+    constexpr size_t k_page_size = 64 * 1024;
+}  // namespace
+
+/// Fills the allocator with chunk-sized (1 to 4 pages) allocations, then frees them.
+static void BM_VirtualAllocator_AllocateFree(benchmark::State &state)
+{
+    size_t page_count = size_t(state.range(0));
+
+    std::vector<size_t> sizes;
+    std::mt19937 random(k_seed);
+    for (size_t allocated_page_count = 0; allocated_page_count < page_count;)
+    {
+        size_t size = k_page_size * (random() % 4 + 1);
+        allocated_page_count += size / k_page_size;
+        sizes.push_back(size);
+    }
+
+    std::vector<size_t> offsets;
+    offsets.reserve(sizes.size());
+
+    for (auto _ : state)
+    {
+        VirtualAllocator allocator(page_count * k_page_size, 256, k_page_size);
+
+        offsets.clear();
+        for (size_t size : sizes)
+        {
+            size_t offset{};
+            if (allocator.allocate(size, offset)) offsets.push_back(offset);
+        }
+
+        for (size_t offset : offsets) allocator.free(offset);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(sizes.size()));
+}
+BENCHMARK(BM_VirtualAllocator_AllocateFree)->ArgName("pages")->Arg(256)->Arg(4096);
+
+/// Steady state of the world view: a full allocator where random allocations are replaced (the free pages are scattered).
+static void BM_VirtualAllocator_Churn(benchmark::State &state)
+{
+    size_t page_count = size_t(state.range(0));
+
+    VirtualAllocator allocator(page_count * k_page_size, 256, k_page_size);
+
+    std::vector<size_t> offsets;
+    for (size_t offset{}; allocator.allocate(k_page_size, offset);) offsets.push_back(offset);
+
+    std::mt19937 random(k_seed);
+    for (auto _ : state)
+    {
+        size_t i = random() % offsets.size();
+        allocator.free(offsets[i]);
+
+        bool allocated = allocator.allocate(k_page_size, offsets[i]);
+        benchmark::DoNotOptimize(allocated);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_VirtualAllocator_Churn)->ArgName("pages")->Arg(256)->Arg(4096);
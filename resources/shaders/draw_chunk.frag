@@ -0,0 +1,17 @@
+#version 460
+
+layout(location = 0) in vec3 v_normal;
+layout(location = 1) in vec2 v_texcoord;
+layout(location = 2) flat in uint v_material_index;
+
+// vren::gbuffer
+layout(location = 0) out vec4 f_normal;
+layout(location = 1) out vec2 f_texcoord;
+layout(location = 2) out uint f_material_index;
+
+void main()
+{
+    f_normal = vec4(normalize(v_normal), 0.0);
+    f_texcoord = v_texcoord;
+    f_material_index = v_material_index;
+}
@@ -0,0 +1,46 @@
+#version 460
+
+// Must match explo::SurfaceVertex (src/world/surface/Surface.hpp)
+layout(location = 0) in uvec2 a_position_xz;
+layout(location = 1) in uint a_position_y;
+layout(location = 2) in uvec2 a_face_block_type;
+
+// SurfaceInstance (per instance)
+layout(location = 3) in mat4 i_transform;
+
+layout(push_constant) uniform PushConstants
+{
+    mat4 camera_view;
+    mat4 camera_projection;
+    uint material_index;
+    uint block_type_count;
+};
+
+layout(location = 0) out vec3 v_normal;
+layout(location = 1) out vec2 v_texcoord;
+layout(location = 2) flat out uint v_material_index;
+
+// Indexed by explo::BlockFace
+const vec3 k_face_normals[6] = vec3[](
+    vec3(-1, 0, 0),
+    vec3(1, 0, 0),
+    vec3(0, -1, 0),
+    vec3(0, 1, 0),
+    vec3(0, 0, -1),
+    vec3(0, 0, 1)
+);
+
+void main()
+{
+    vec3 position = vec3(a_position_xz.x, a_position_y, a_position_xz.y);  // Relative to the chunk, in blocks
+    vec4 world_position = i_transform * vec4(position, 1.0);
+
+    gl_Position = camera_projection * camera_view * world_position;
+
+    uint face = a_face_block_type.x;
+    uint block_type = a_face_block_type.y;
+
+    v_normal = normalize(mat3(i_transform) * k_face_normals[face]);
+    v_texcoord = vec2((float(block_type) + 0.5) / float(block_type_count), 0.5);  // The block atlas has one texel per block type
+    v_material_index = material_index;
+}
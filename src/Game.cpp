@@ -1,5 +1,6 @@
 #include "Game.hpp"
 
+#include "util/Profiler.hpp"
 #include "video/RenderApi.hpp"
 
 using namespace explo;
@@ -9,9 +10,15 @@ Game::Game(GlfwWindow &window) :
     m_main_thread_executor{},
     m_thread_pool(std::thread::hardware_concurrency()),
 
+    /* World */
+    m_render_sink(m_main_thread_executor),
+    m_block_registry(m_render_sink),
+
     /* Video */
     m_window(window)
 {
+    PROFILE_THREAD_NAME("Main");
+
     m_debug_ui = std::make_unique<DebugUi>(RenderApi::renderer());
 
     RenderApi::ui_draw(
@@ -47,9 +54,10 @@ Game::~Game()
 
 void Game::late_initialize()
 {
-    m_world = std::make_shared<World>(m_volume_generator, m_surface_generator);
+    SurfaceGenerator &surface_generator = m_greedy_meshing ? static_cast<SurfaceGenerator &>(m_greedy_surface_generator) : m_blocky_surface_generator;
+    m_world = std::make_shared<World>(m_volume_generator, surface_generator, m_thread_pool);
 
-    m_player = std::make_shared<Entity>(*m_world, glm::vec3(0, 10, 0));
+    m_player = std::make_shared<Entity>(*m_world, m_render_sink, glm::vec3(0, 10, 0));
     m_player_controller = std::make_unique<EntityController>(*m_player);
 
     const glm::ivec3 k_render_distance(20, 0, 20);
@@ -60,14 +68,14 @@ void Game::late_initialize()
     RenderApi::camera_set_projection_params(90.0f, 1.0f, 0.01f, 1000.0f);
 }
 
-void Game::run_on_main_thread(std::function<void()> const &job)
+void Game::run_on_main_thread(Job job)
 {
-    m_main_thread_executor.enqueue_job(job);
+    m_main_thread_executor.enqueue_job(std::move(job));
 }
 
-void Game::run_async(std::function<void()> const &job)
+void Game::run_async(Job job)
 {
-    m_thread_pool.enqueue_job(job);
+    m_thread_pool.enqueue_job(std::move(job));
 }
 
 void Game::on_window_resize(uint32_t width, uint32_t height)
@@ -77,6 +85,8 @@ void Game::on_window_resize(uint32_t width, uint32_t height)
 
 void Game::render()
 {
+    PROFILE_SCOPE("Game::render");
+
     m_fps_counter++;
 
     // FPS
@@ -95,7 +105,7 @@ void Game::render()
 
     m_last_frame_time = (float)glfwGetTime();
 
-    m_main_thread_executor.process();  // Process main thread jobs
+    m_main_thread_executor.process(m_main_thread_budget);  // Process main thread jobs
 
     if (m_player_controller->update_position()) RenderApi::camera_set_position(m_player->get_position());
 
@@ -150,12 +160,12 @@ Game &explo::game()
     return *s_game;
 }
 
-void explo::run_on_main_thread(std::function<void()> const &job)
+void explo::run_on_main_thread(Job job)
 {
-    s_game->run_on_main_thread(job);
+    s_game->run_on_main_thread(std::move(job));
 }
 
-void explo::run_async(std::function<void()> const &job)
+void explo::run_async(Job job)
 {
-    s_game->run_async(job);
+    s_game->run_async(std::move(job));
 }
@@ -5,9 +5,11 @@
 #include "util/SyncJobExecutor.hpp"
 #include "util/ThreadPool.hpp"
 #include "video/DebugUi.hpp"
+#include "video/RendererSink.hpp"
 #include "world/BlockRegistry.hpp"
 #include "world/Entity.hpp"
 #include "world/surface/BlockySurfaceGenerator.hpp"
+#include "world/surface/GreedySurfaceGenerator.hpp"
 #include "world/volume/PerlinNoiseGenerator.hpp"
 #include "world/volume/SinCosVolumeGenerator.hpp"
 
@@ -18,12 +20,21 @@ namespace explo
     public:
         /* Misc utils */
         SyncJobExecutor m_main_thread_executor;
+
+        /// Bounds the main thread jobs run per frame (e.g. chunk uploads), the remaining ones are carried over to the next frames.
+        SyncJobExecutor::Budget m_main_thread_budget{.m_max_time_ns = 4'000'000};
+
         ThreadPool m_thread_pool;
 
         /* World */
+        RendererSink m_render_sink;
         BlockRegistry m_block_registry;
         PerlinNoiseGenerator m_volume_generator;
-        BlockySurfaceGenerator m_surface_generator;
+        BlockySurfaceGenerator m_blocky_surface_generator;
+        GreedySurfaceGenerator m_greedy_surface_generator;
+
+        /// Meshes the chunks with the GreedySurfaceGenerator rather than the BlockySurfaceGenerator. Read when the world is created.
+        bool m_greedy_meshing = false;
 
         /* Video */
         GlfwWindow &m_window;
@@ -51,8 +62,8 @@ namespace explo
 
         /* Job executors */
 
-        void run_on_main_thread(std::function<void()> const &job);
-        void run_async(std::function<void()> const &job);
+        void run_on_main_thread(Job job);
+        void run_async(Job job);
 
         void on_window_resize(uint32_t width, uint32_t height);
         void render();
@@ -74,6 +85,6 @@ namespace explo
 
     /* Helpers */
 
-    void run_on_main_thread(std::function<void()> const &job);
-    void run_async(std::function<void()> const &job);
+    void run_on_main_thread(Job job);
+    void run_async(Job job);
 }  // namespace explo
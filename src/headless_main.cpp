@@ -0,0 +1,162 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <glm/gtc/constants.hpp>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include "util/Profiler.hpp"
+#include "util/ThreadPool.hpp"
+#include "util/misc.hpp"
+#include "util/profile_stats.hpp"
+#include "video/RecordingRenderSink.hpp"
+#include "world/BlockRegistry.hpp"
+#include "world/Entity.hpp"
+#include "world/World.hpp"
+#include "world/surface/BlockySurfaceGenerator.hpp"
+#include "world/volume/PerlinNoiseGenerator.hpp"
+
+using namespace explo;
+
+// Streams the world without a window nor a renderer: an entity walks along a square path, one chunk per step, and every step waits for
+// the world view around it to be generated. Prints the generation throughput and the pop-in latency, and optionally dumps the chunk
+// pipeline metrics as JSON and the profiler zones as a Chrome trace.
+//
+// Usage: explo_headless [render_distance = 8] [step_count = 32] [thread_count = hardware concurrency] [metrics_path] [trace_path]
+
+namespace
+{
+    constexpr uint64_t k_step_timeout_ns = 60'000'000'000;
+
+    /// Waits for every chunk of the world view to be uploaded at least once.
+    /// \return The time waited in nanoseconds, or nothing on timeout.
+    std::optional<uint64_t> wait_for_world_view(RecordingRenderSink const &render_sink, size_t world_view_size)
+    {
+        uint64_t started_at = get_steady_nanos();
+        while (render_sink.get_resident_chunk_count() < world_view_size)
+        {
+            if (get_steady_nanos() - started_at > k_step_timeout_ns) return std::nullopt;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        return get_steady_nanos() - started_at;
+    }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    int render_distance = argc > 1 ? std::atoi(argv[1]) : 8;
+    int step_count = argc > 2 ? std::atoi(argv[2]) : 32;
+    size_t thread_count = argc > 3 ? size_t(std::atoi(argv[3])) : std::thread::hardware_concurrency();
+    char const *metrics_path = argc > 4 ? argv[4] : nullptr;
+    char const *trace_path = argc > 5 ? argv[5] : nullptr;
+
+    if (render_distance < 0 || step_count < 0 || thread_count == 0)
+    {
+        fprintf(stderr, "Usage: %s [render_distance] [step_count] [thread_count] [metrics_path] [trace_path]\n", argv[0]);
+        return 1;
+    }
+
+    PROFILE_THREAD_NAME("Main");
+
+    // Declared before the thread pool, so that they outlive the jobs still running on exit
+    RecordingRenderSink render_sink{};
+    BlockRegistry block_registry(render_sink);
+    PerlinNoiseGenerator volume_generator{};
+    BlockySurfaceGenerator surface_generator{};
+
+    ThreadPool thread_pool(thread_count);
+
+    std::shared_ptr<World> world = std::make_shared<World>(volume_generator, surface_generator, thread_pool);
+    Entity entity(*world, render_sink, glm::vec3(8, 10, 8));  // At the center of a chunk, so that the steps never fall on a border
+
+    // Spawn
+    glm::ivec3 render_distance_3d(render_distance, 0, render_distance);
+    glm::ivec3 side = render_distance_3d * 2 + 1;
+    size_t world_view_size = size_t(side.x) * size_t(side.y) * size_t(side.z);
+
+    printf("Render distance: %d, steps: %d, threads: %zu\n", render_distance, step_count, thread_count);
+
+    entity.recreate_world_view(render_distance_3d);
+
+    std::optional<uint64_t> spawn_time = wait_for_world_view(render_sink, world_view_size);
+    if (!spawn_time)
+    {
+        fprintf(stderr, "Timed out generating the spawn world view\n");
+        return 1;
+    }
+
+    printf("Spawn: %zu chunks in %.3f ms\n", world_view_size, *spawn_time / 1'000'000.0);
+
+    // Walk along a square, turning a quarter at every side
+    profile_stats step_stats{};
+    uint64_t walk_started_at = get_steady_nanos();
+
+    for (int step = 0; step < step_count; step++)
+    {
+        float yaw = float(step * 4 / glm::max(step_count, 1)) * glm::half_pi<float>();
+        entity.set_rotation(yaw, 0.0f);
+        entity.set_position(entity.get_position() + entity.get_forward() * Chunk::k_world_size);
+
+        std::optional<uint64_t> step_time = wait_for_world_view(render_sink, world_view_size);
+        if (!step_time)
+        {
+            fprintf(stderr, "Timed out generating the world view at step %d\n", step);
+            return 1;
+        }
+
+        step_stats.push_elapsed_time(*step_time);
+    }
+
+    uint64_t walk_time = get_steady_nanos() - walk_started_at;
+
+    RecordingRenderSink::Counters counters = render_sink.get_counters();
+    size_t generated_chunk_count = world_view_size + size_t(step_count) * size_t(side.x * side.y);  // A slab enters per step
+
+    if (step_count > 0)
+    {
+        printf(
+            "Walk: %d steps in %.3f ms (step min: %.3f ms, avg: %.3f ms, max: %.3f ms)\n",
+            step_count,
+            walk_time / 1'000'000.0,
+            step_stats.min_ms(),
+            step_stats.avg_ms(),
+            step_stats.max_ms()
+        );
+    }
+
+    printf(
+        "Chunks generated: %zu (%.1f chunks/s), uploads: %zu (ignored: %zu)\n",
+        generated_chunk_count,
+        generated_chunk_count / ((*spawn_time + walk_time) / 1'000'000'000.0),
+        counters.m_upload_count,
+        counters.m_ignored_upload_count
+    );
+
+    ChunkMetrics const &chunk_metrics = world->get_chunk_metrics();
+    LatencyHistogram const &pop_in_latency = chunk_metrics.get_stage_latency(ChunkStage_Uploaded);
+    printf(
+        "Pop-in latency: p50: %.3f ms, p95: %.3f ms, p99: %.3f ms, max: %.3f ms\n",
+        pop_in_latency.get_quantile_ms(0.50),
+        pop_in_latency.get_quantile_ms(0.95),
+        pop_in_latency.get_quantile_ms(0.99),
+        pop_in_latency.get_max_ms()
+    );
+
+    if (metrics_path)
+    {
+        std::ofstream stream(metrics_path);
+        chunk_metrics.write_json(stream);
+    }
+
+    if (trace_path)
+    {
+        std::ofstream stream(trace_path);
+        profiler().write_chrome_trace(stream);
+    }
+
+    return 0;
+}
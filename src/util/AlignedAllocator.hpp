@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace explo
+{
+    /// A minimal std allocator returning memory aligned to the given boundary (e.g. to make a std::vector start on a cache line).
+    template <typename _T, size_t _alignment>
+    class AlignedAllocator
+    {
+    public:
+        using value_type = _T;
+
+        template <typename _U>
+        struct rebind
+        {
+            using other = AlignedAllocator<_U, _alignment>;
+        };
+
+        AlignedAllocator() = default;
+
+        template <typename _U>
+        AlignedAllocator(AlignedAllocator<_U, _alignment> const &)
+        {
+        }
+
+        _T *allocate(size_t n) { return static_cast<_T *>(::operator new(n * sizeof(_T), std::align_val_t(_alignment))); }
+        void deallocate(_T *ptr, size_t n) { ::operator delete(ptr, std::align_val_t(_alignment)); }
+
+        template <typename _U>
+        bool operator==(AlignedAllocator<_U, _alignment> const &) const
+        {
+            return true;
+        }
+
+        template <typename _U>
+        bool operator!=(AlignedAllocator<_U, _alignment> const &) const
+        {
+            return false;
+        }
+    };
+}  // namespace explo
@@ -0,0 +1,115 @@
+#include "BlockPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace explo;
+
+namespace
+{
+    constexpr size_t k_size_class_count = std::bit_width(BlockPool::k_max_block_size) - std::bit_width(BlockPool::k_min_block_size) + 1;
+
+    constexpr size_t k_cache_capacity = 64;           ///< The free blocks a thread keeps per class
+    constexpr size_t k_batch_size = k_cache_capacity / 2;  ///< The blocks moved at once between a thread cache and the shared list
+
+    size_t get_size_class(size_t size)
+    {
+        if (size <= BlockPool::k_min_block_size) return 0;
+        return std::bit_width(size - 1) - std::bit_width(BlockPool::k_min_block_size - 1);
+    }
+
+    size_t get_block_size(size_t size_class)
+    {
+        return BlockPool::k_min_block_size << size_class;
+    }
+
+    struct SharedList
+    {
+        std::mutex m_mutex;
+        std::vector<void *> m_blocks;
+    };
+
+    /// Never destroyed, as the thread caches give their blocks back on thread exit (possibly after the static destructors).
+    std::array<SharedList, k_size_class_count> &get_shared_lists()
+    {
+        static auto *shared_lists = new std::array<SharedList, k_size_class_count>();
+        return *shared_lists;
+    }
+
+    struct ThreadCache
+    {
+        struct Class
+        {
+            std::array<void *, k_cache_capacity> m_blocks;
+            size_t m_count = 0;
+        };
+
+        std::array<Class, k_size_class_count> m_classes{};
+
+        ~ThreadCache()
+        {
+            for (size_t size_class = 0; size_class < k_size_class_count; size_class++)
+            {
+                Class &cache = m_classes[size_class];
+
+                SharedList &shared_list = get_shared_lists()[size_class];
+                std::lock_guard<std::mutex> lock(shared_list.m_mutex);
+                shared_list.m_blocks.insert(shared_list.m_blocks.end(), cache.m_blocks.begin(), cache.m_blocks.begin() + cache.m_count);
+            }
+        }
+    };
+
+    thread_local ThreadCache thread_cache{};
+}  // namespace
+
+void *BlockPool::allocate(size_t size)
+{
+    if (size > k_max_block_size) return ::operator new(size);
+
+    size_t size_class = get_size_class(size);
+    ThreadCache::Class &cache = thread_cache.m_classes[size_class];
+
+    if (cache.m_count == 0)
+    {
+        // Refill the cache from the shared list
+        SharedList &shared_list = get_shared_lists()[size_class];
+        std::lock_guard<std::mutex> lock(shared_list.m_mutex);
+
+        size_t count = std::min(k_batch_size, shared_list.m_blocks.size());
+        std::copy(shared_list.m_blocks.end() - count, shared_list.m_blocks.end(), cache.m_blocks.begin());
+        shared_list.m_blocks.resize(shared_list.m_blocks.size() - count);
+        cache.m_count = count;
+    }
+
+    if (cache.m_count == 0) return ::operator new(get_block_size(size_class));
+
+    return cache.m_blocks[--cache.m_count];
+}
+
+void BlockPool::deallocate(void *block, size_t size)
+{
+    if (size > k_max_block_size)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    size_t size_class = get_size_class(size);
+    ThreadCache::Class &cache = thread_cache.m_classes[size_class];
+
+    if (cache.m_count == k_cache_capacity)
+    {
+        // Give half of the cache back, so that the blocks released by this thread can be reused by the threads allocating them
+        SharedList &shared_list = get_shared_lists()[size_class];
+        std::lock_guard<std::mutex> lock(shared_list.m_mutex);
+
+        shared_list.m_blocks.insert(shared_list.m_blocks.end(), cache.m_blocks.end() - k_batch_size, cache.m_blocks.end());
+        cache.m_count -= k_batch_size;
+    }
+
+    cache.m_blocks[cache.m_count++] = block;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+
+namespace explo
+{
+    /// A thread-safe pool of small memory blocks, by power-of-two size class (from k_min_block_size to k_max_block_size bytes).
+    ///
+    /// Every thread keeps a small cache of free blocks per class, exchanged in batches with a shared list: the blocks allocated by a
+    /// thread and released by another (e.g. the jobs enqueued by the main thread and run by the workers) flow back without hitting the
+    /// system allocator once the pool is warm. The memory is never given back to the system.
+    class BlockPool
+    {
+    public:
+        static constexpr size_t k_min_block_size = 64;
+        static constexpr size_t k_max_block_size = 1024;
+
+        /// Allocates a block of at least the given size. Sizes above k_max_block_size are forwarded to the system allocator.
+        static void *allocate(size_t size);
+
+        /// Releases a block allocated with allocate(), the size must be the same.
+        static void deallocate(void *block, size_t size);
+    };
+
+    /// A minimal std allocator over the BlockPool, e.g. to allocate_shared the objects created and released at a high rate.
+    template <typename _T>
+    class BlockPoolAllocator
+    {
+        static_assert(alignof(_T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "The BlockPool blocks only have the default new alignment");
+
+    public:
+        using value_type = _T;
+
+        template <typename _U>
+        struct rebind
+        {
+            using other = BlockPoolAllocator<_U>;
+        };
+
+        BlockPoolAllocator() = default;
+
+        template <typename _U>
+        BlockPoolAllocator(BlockPoolAllocator<_U> const &)
+        {
+        }
+
+        _T *allocate(size_t n) { return static_cast<_T *>(BlockPool::allocate(n * sizeof(_T))); }
+        void deallocate(_T *ptr, size_t n) { BlockPool::deallocate(ptr, n * sizeof(_T)); }
+
+        template <typename _U>
+        bool operator==(BlockPoolAllocator<_U> const &) const
+        {
+            return true;
+        }
+
+        template <typename _U>
+        bool operator!=(BlockPoolAllocator<_U> const &) const
+        {
+            return false;
+        }
+    };
+}  // namespace explo
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "BlockPool.hpp"
+
+namespace explo
+{
+    /// A move-only void() callable, replacing std::function for the jobs. Callables up to k_inline_size bytes (e.g. a lambda capturing
+    /// two weak_ptr and a std::function) are stored inline, the larger ones in a BlockPool block: once the pools are warm, creating and
+    /// running a job doesn't allocate.
+    class Job
+    {
+    public:
+        static constexpr size_t k_inline_size = 64;
+
+    private:
+        struct Operations
+        {
+            void (*m_invoke)(void *storage);
+            void (*m_move)(void *dst_storage, void *src_storage);  ///< Move-constructs into dst and destroys src
+            void (*m_destroy)(void *storage);
+        };
+
+        template <typename _CallableT>
+        static constexpr bool is_inline_v = sizeof(_CallableT) <= k_inline_size && alignof(_CallableT) <= alignof(std::max_align_t) &&
+                                            std::is_nothrow_move_constructible_v<_CallableT>;
+
+        template <typename _CallableT>
+        struct InlineOperations
+        {
+            static void invoke(void *storage) { (*std::launder(static_cast<_CallableT *>(storage)))(); }
+
+            static void move(void *dst_storage, void *src_storage)
+            {
+                _CallableT *src = std::launder(static_cast<_CallableT *>(src_storage));
+                new (dst_storage) _CallableT(std::move(*src));
+                src->~_CallableT();
+            }
+
+            static void destroy(void *storage) { std::launder(static_cast<_CallableT *>(storage))->~_CallableT(); }
+
+            static constexpr Operations k_operations{&invoke, &move, &destroy};
+        };
+
+        /// The storage holds a pointer to the callable, living in a BlockPool block.
+        template <typename _CallableT>
+        struct PooledOperations
+        {
+            static _CallableT *get(void *storage) { return *static_cast<_CallableT **>(storage); }
+
+            static void invoke(void *storage) { (*get(storage))(); }
+
+            static void move(void *dst_storage, void *src_storage) { *static_cast<_CallableT **>(dst_storage) = get(src_storage); }
+
+            static void destroy(void *storage)
+            {
+                _CallableT *callable = get(storage);
+                callable->~_CallableT();
+                BlockPool::deallocate(callable, sizeof(_CallableT));
+            }
+
+            static constexpr Operations k_operations{&invoke, &move, &destroy};
+        };
+
+        alignas(std::max_align_t) std::byte m_storage[k_inline_size];
+        Operations const *m_operations = nullptr;
+
+    public:
+        Job() = default;
+        Job(std::nullptr_t) {}
+
+        template <typename _CallableT, typename = std::enable_if_t<!std::is_same_v<std::decay_t<_CallableT>, Job>>>
+        Job(_CallableT &&callable)
+        {
+            using CallableT = std::decay_t<_CallableT>;
+            static_assert(alignof(CallableT) <= alignof(std::max_align_t), "Over-aligned callables aren't supported");
+
+            if constexpr (is_inline_v<CallableT>)
+            {
+                new (m_storage) CallableT(std::forward<_CallableT>(callable));
+                m_operations = &InlineOperations<CallableT>::k_operations;
+            }
+            else
+            {
+                void *block = BlockPool::allocate(sizeof(CallableT));
+                *reinterpret_cast<CallableT **>(m_storage) = new (block) CallableT(std::forward<_CallableT>(callable));
+                m_operations = &PooledOperations<CallableT>::k_operations;
+            }
+        }
+
+        Job(Job &&other) noexcept :
+            m_operations(other.m_operations)
+        {
+            if (m_operations) m_operations->m_move(m_storage, other.m_storage);
+            other.m_operations = nullptr;
+        }
+
+        Job &operator=(Job &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+
+                m_operations = other.m_operations;
+                if (m_operations) m_operations->m_move(m_storage, other.m_storage);
+                other.m_operations = nullptr;
+            }
+            return *this;
+        }
+
+        Job &operator=(std::nullptr_t)
+        {
+            reset();
+            return *this;
+        }
+
+        Job(Job const &) = delete;
+        Job &operator=(Job const &) = delete;
+
+        ~Job() { reset(); }
+
+        explicit operator bool() const { return m_operations != nullptr; }
+
+        /// Calls the callable. Like std::function, the callable is called as non-const.
+        void operator()() const { m_operations->m_invoke(const_cast<std::byte *>(m_storage)); }
+
+        /// Destroys the callable (and the resources it captured).
+        void reset()
+        {
+            if (m_operations) m_operations->m_destroy(m_storage);
+            m_operations = nullptr;
+        }
+    };
+}  // namespace explo
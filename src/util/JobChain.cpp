@@ -6,9 +6,9 @@ JobChain::JobChain() {}
 
 JobChain::~JobChain() {}
 
-JobChain &JobChain::then(JobT const &job)
+JobChain &JobChain::then(JobT job)
 {
-    m_jobs.push_back(job);
+    m_jobs.push_back(std::move(job));
     return *this;
 }
 
@@ -17,25 +17,35 @@ void JobChain::dispatch() const
     for (JobT const &job : m_jobs) job();
 }
 
-void enqueue_on_thread_pool(ThreadPool &thread_pool, std::list<JobChain::JobT> const &jobs)
+// The stages share the jobs and only carry an index, so that enqueuing the next one doesn't copy the rest of the chain
+void enqueue_on_thread_pool(
+    ThreadPool &thread_pool, std::shared_ptr<std::vector<JobChain::JobT>> jobs, size_t job_index, std::shared_ptr<JobToken> const &token
+)
 {
+    if (job_index >= jobs->size()) return;
+
     thread_pool.enqueue_job(
-        [&thread_pool, jobs = jobs]() mutable
+        [&thread_pool, jobs = std::move(jobs), job_index, token]() mutable
         {
-            if (!jobs.empty())
-            {
-                JobChain::JobT job = jobs.front();
-                jobs.pop_front();
+            JobChain::JobT &job = (*jobs)[job_index];
+            job();
+            job = nullptr;  // Release the captures now
 
-                job();
+            if (token && token->is_cancelled()) return;
 
-                enqueue_on_thread_pool(thread_pool, jobs);
-            }
-        }
+            enqueue_on_thread_pool(thread_pool, std::move(jobs), job_index + 1, token);
+        },
+        token
     );
 }
 
-void JobChain::dispatch(ThreadPool &thread_pool) const
+void JobChain::dispatch(ThreadPool &thread_pool)
+{
+    dispatch(thread_pool, nullptr);
+}
+
+void JobChain::dispatch(ThreadPool &thread_pool, std::shared_ptr<JobToken> const &token)
 {
-    enqueue_on_thread_pool(thread_pool, m_jobs);
+    enqueue_on_thread_pool(thread_pool, std::make_shared<std::vector<JobT>>(std::move(m_jobs)), 0, token);
+    m_jobs.clear();
 }
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <functional>
+#include <memory>
+#include <vector>
 
+#include "Job.hpp"
 #include "ThreadPool.hpp"
 
 namespace explo
@@ -10,19 +12,24 @@ namespace explo
     class JobChain
     {
     public:
-        using JobT = std::function<void()>;
+        using JobT = Job;
 
     private:
-        std::list<JobT> m_jobs;
+        std::vector<JobT> m_jobs;
 
     public:
         explicit JobChain();
         ~JobChain();
 
-        JobChain &then(JobT const &job);
+        JobChain &then(JobT job);
 
         void dispatch() const;
-        void dispatch(ThreadPool &thread_pool) const;
+
+        /// Moves the jobs to the thread pool, the chain is left empty.
+        void dispatch(ThreadPool &thread_pool);
+
+        /// Dispatches every job on the priority queue of the thread pool: the jobs left are dropped once the token is cancelled.
+        void dispatch(ThreadPool &thread_pool, std::shared_ptr<JobToken> const &token);
     };
 
 }  // namespace explo
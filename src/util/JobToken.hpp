@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+
+namespace explo
+{
+    /// Shared between the jobs of a task (e.g. the generation of a chunk) and the task owner. The owner can change the priority of the
+    /// jobs still queued, or cancel them: the queued jobs are dropped and the running ones are expected to poll is_cancelled().
+    class JobToken
+    {
+    private:
+        std::atomic<bool> m_cancelled = false;
+        std::atomic<float> m_priority = 0.0f;  ///< Lowest first
+
+    public:
+        explicit JobToken(float priority = 0.0f) :
+            m_priority(priority)
+        {
+        }
+
+        ~JobToken() = default;
+
+        bool is_cancelled() const { return m_cancelled.load(std::memory_order_relaxed); }
+        void cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+
+        float get_priority() const { return m_priority.load(std::memory_order_relaxed); }
+
+        /// Sets the priority of the jobs. The jobs already queued are only reordered by ThreadPool::update_priorities().
+        void set_priority(float priority) { m_priority.store(priority, std::memory_order_relaxed); }
+    };
+}  // namespace explo
@@ -0,0 +1,99 @@
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+using namespace explo;
+
+void LatencyHistogram::record(uint64_t value)
+{
+    m_bucket_counts[get_bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::merge(LatencyHistogram const &other)
+{
+    for (uint32_t i = 0; i < k_bucket_count; i++)
+    {
+        uint64_t bucket_count = other.m_bucket_counts[i].load(std::memory_order_relaxed);
+        if (bucket_count > 0) m_bucket_counts[i].fetch_add(bucket_count, std::memory_order_relaxed);
+    }
+
+    m_count.fetch_add(other.m_count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_sum.fetch_add(other.m_sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    uint64_t other_max = other.get_max();
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (other_max > max && !m_max.compare_exchange_weak(max, other_max, std::memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::reset()
+{
+    for (std::atomic<uint64_t> &bucket_count : m_bucket_counts) bucket_count.store(0, std::memory_order_relaxed);
+
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::get_mean() const
+{
+    uint64_t count = get_count();
+    return count > 0 ? double(m_sum.load(std::memory_order_relaxed)) / double(count) : 0.0;
+}
+
+uint64_t LatencyHistogram::get_quantile(double quantile) const
+{
+    // Snapshot the buckets so that the total matches them, even while recording
+    std::array<uint64_t, k_bucket_count> bucket_counts;
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < k_bucket_count; i++)
+    {
+        bucket_counts[i] = m_bucket_counts[i].load(std::memory_order_relaxed);
+        count += bucket_counts[i];
+    }
+
+    if (count == 0) return 0;
+
+    // The rank of the sample, starting from 1
+    uint64_t rank = std::max(uint64_t(std::ceil(std::clamp(quantile, 0.0, 1.0) * double(count))), uint64_t(1));
+
+    uint64_t cumulative_count = 0;
+    for (uint32_t i = 0; i < k_bucket_count; i++)
+    {
+        cumulative_count += bucket_counts[i];
+        if (cumulative_count >= rank) return std::min(get_bucket_lower_bound(i) + get_bucket_width(i) / 2, get_max());
+    }
+
+    return get_max();
+}
+
+uint32_t LatencyHistogram::get_bucket_index(uint64_t value)
+{
+    if (value < 2 * k_sub_bucket_count) return uint32_t(value);
+
+    // The k_sub_bucket_bits bits following the most significant one select the linear bucket within the power of two
+    uint32_t shift = uint32_t(std::bit_width(value)) - 1 - k_sub_bucket_bits;
+    return (shift + 1) * k_sub_bucket_count + uint32_t(value >> shift) - k_sub_bucket_count;
+}
+
+uint64_t LatencyHistogram::get_bucket_lower_bound(uint32_t bucket_index)
+{
+    if (bucket_index < 2 * k_sub_bucket_count) return bucket_index;
+
+    uint32_t shift = bucket_index / k_sub_bucket_count - 1;
+    return uint64_t(k_sub_bucket_count + bucket_index % k_sub_bucket_count) << shift;
+}
+
+uint64_t LatencyHistogram::get_bucket_width(uint32_t bucket_index)
+{
+    if (bucket_index < 2 * k_sub_bucket_count) return 1;
+
+    return uint64_t(1) << (bucket_index / k_sub_bucket_count - 1);
+}
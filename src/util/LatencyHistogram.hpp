@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace explo
+{
+    /// A histogram of latencies (in nanoseconds, but any unsigned quantity works) with log-linear buckets, as HdrHistogram: every power of
+    /// two is split into k_sub_bucket_count linear buckets, so that the quantiles have the same relative error (below 1/k_sub_bucket_count)
+    /// whatever the magnitude.
+    ///
+    /// Recording is lock-free (relaxed atomic increments) and can be done from any thread. The reads are consistent once recording is over,
+    /// approximate while recording.
+    class LatencyHistogram
+    {
+    public:
+        static constexpr uint32_t k_sub_bucket_bits = 4;
+        static constexpr uint32_t k_sub_bucket_count = 1 << k_sub_bucket_bits;
+
+        /// The values below 2 * k_sub_bucket_count have a bucket each, then every power of two up to 2^63 takes k_sub_bucket_count buckets.
+        static constexpr uint32_t k_bucket_count = (64 - k_sub_bucket_bits + 1) * k_sub_bucket_count;
+
+    private:
+        std::array<std::atomic<uint64_t>, k_bucket_count> m_bucket_counts{};
+
+        std::atomic<uint64_t> m_count = 0;
+        std::atomic<uint64_t> m_sum = 0;
+        std::atomic<uint64_t> m_max = 0;
+
+    public:
+        explicit LatencyHistogram() = default;
+        ~LatencyHistogram() = default;
+
+        void record(uint64_t value);
+
+        /// Adds the samples of the other histogram to this one (e.g. to merge per-thread histograms on read).
+        void merge(LatencyHistogram const &other);
+
+        /// Clears the samples. Not atomic: samples recorded meanwhile could be partially kept.
+        void reset();
+
+        uint64_t get_count() const { return m_count.load(std::memory_order_relaxed); }
+        uint64_t get_max() const { return m_max.load(std::memory_order_relaxed); }
+        double get_mean() const;
+
+        /// Returns the value below which the given fraction (between 0 and 1) of the samples lie, 0 if there's no sample. The value is the
+        /// middle of its bucket (clamped to the maximum recorded).
+        uint64_t get_quantile(double quantile) const;
+
+        double get_quantile_ms(double quantile) const { return get_quantile(quantile) / 1'000'000.0; }
+        double get_max_ms() const { return get_max() / 1'000'000.0; }
+        double get_mean_ms() const { return get_mean() / 1'000'000.0; }
+
+        static uint32_t get_bucket_index(uint64_t value);
+
+        /// Returns the smallest value falling within the bucket.
+        static uint64_t get_bucket_lower_bound(uint32_t bucket_index);
+        static uint64_t get_bucket_width(uint32_t bucket_index);
+    };
+}  // namespace explo
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace explo
+{
+    /// A lock-free multi-producer single-consumer FIFO queue (Vyukov's intrusive MPSC): a push is one atomic exchange and never waits on
+    /// the consumer.
+    ///
+    /// The nodes are pooled: the consumer gives them back to a shared free list, that producers take as a whole into a thread local
+    /// cache when theirs is empty (so that no node is ever popped from the free list on its own, which would be prone to ABA).
+    template <typename _T>
+    class MpscQueue
+    {
+    private:
+        struct Node
+        {
+            std::atomic<Node *> m_next = nullptr;
+            _T m_value{};
+        };
+
+        /// The nodes available to the producer thread, shared by the queues of the same type.
+        struct NodeCache
+        {
+            Node *m_head = nullptr;
+
+            ~NodeCache()
+            {
+                while (m_head)
+                {
+                    Node *next = m_head->m_next.load(std::memory_order_relaxed);
+                    delete m_head;
+                    m_head = next;
+                }
+            }
+        };
+
+        inline static thread_local NodeCache s_node_cache{};
+
+        alignas(64) std::atomic<Node *> m_head;  ///< The last pushed node, written by the producers
+        alignas(64) Node *m_tail;                ///< The next node to pop, only accessed by the consumer
+        Node m_stub;
+
+        alignas(64) std::atomic<Node *> m_free_nodes = nullptr;
+        std::atomic<size_t> m_size = 0;
+
+    public:
+        explicit MpscQueue() :
+            m_head(&m_stub),
+            m_tail(&m_stub)
+        {
+        }
+
+        ~MpscQueue()
+        {
+            while (pop()) {}
+
+            Node *node = m_free_nodes.load(std::memory_order_relaxed);
+            while (node)
+            {
+                Node *next = node->m_next.load(std::memory_order_relaxed);
+                delete node;
+                node = next;
+            }
+        }
+
+        MpscQueue(MpscQueue const &) = delete;
+        MpscQueue &operator=(MpscQueue const &) = delete;
+
+        /// Returns the number of values pushed and not popped yet.
+        size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+        /// Pushes the value. Can be called by any thread.
+        void push(_T value)
+        {
+            Node *node = allocate_node();
+            node->m_value = std::move(value);
+
+            m_size.fetch_add(1, std::memory_order_relaxed);
+            push_node(node);
+        }
+
+        /// Pops the first value. Must only be called by the consumer thread.
+        ///
+        /// Can return nothing while the queue isn't empty, if a producer has been interrupted in the middle of a push: the values pushed
+        /// afterwards are held until it completes.
+        std::optional<_T> pop()
+        {
+            Node *tail = m_tail;
+            Node *next = tail->m_next.load(std::memory_order_acquire);
+
+            if (tail == &m_stub)
+            {
+                if (!next) return std::nullopt;  // Empty
+
+                m_tail = next;
+                tail = next;
+                next = next->m_next.load(std::memory_order_acquire);
+            }
+
+            if (!next)
+            {
+                if (tail != m_head.load(std::memory_order_acquire)) return std::nullopt;  // A push is in progress
+
+                // The tail is the last node: push the stub after it so that it can be unlinked
+                push_node(&m_stub);
+                next = tail->m_next.load(std::memory_order_acquire);
+                if (!next) return std::nullopt;
+            }
+
+            m_tail = next;
+
+            std::optional<_T> value(std::move(tail->m_value));
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+
+            free_node(tail);
+            return value;
+        }
+
+    private:
+        void push_node(Node *node)
+        {
+            node->m_next.store(nullptr, std::memory_order_relaxed);
+            Node *prev = m_head.exchange(node, std::memory_order_acq_rel);
+            prev->m_next.store(node, std::memory_order_release);
+        }
+
+        Node *allocate_node()
+        {
+            NodeCache &cache = s_node_cache;
+            if (!cache.m_head) cache.m_head = m_free_nodes.exchange(nullptr, std::memory_order_acquire);
+            if (!cache.m_head) return new Node();
+
+            Node *node = cache.m_head;
+            cache.m_head = node->m_next.load(std::memory_order_relaxed);
+            return node;
+        }
+
+        void free_node(Node *node)
+        {
+            node->m_value = _T{};  // Release what the value holds now, not when the node is reused
+
+            Node *head = m_free_nodes.load(std::memory_order_relaxed);
+            do
+            {
+                node->m_next.store(head, std::memory_order_relaxed);
+            } while (!m_free_nodes.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+        }
+    };
+}  // namespace explo
@@ -0,0 +1,159 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <utility>
+
+using namespace explo;
+
+namespace
+{
+    std::atomic<uint64_t> next_profiler_id = 0;
+
+    // The buffers of the calling thread, by profiler id (a thread usually records to a single profiler)
+    thread_local std::vector<std::pair<uint64_t, void *>> thread_buffers;
+
+    void write_json_string(std::ostream &stream, char const *string)
+    {
+        stream << '"';
+        for (char const *c = string; *c != '\0'; c++)
+        {
+            if (*c == '"' || *c == '\\') stream << '\\';
+            stream << *c;
+        }
+        stream << '"';
+    }
+}  // namespace
+
+Profiler::Profiler() :
+    m_id(next_profiler_id++),
+    m_started_at_ns(get_now_ns())
+{
+}
+
+Profiler::~Profiler() {}
+
+void Profiler::record_zone(char const *name, uint64_t begin_ns, uint64_t end_ns)
+{
+    ThreadBuffer &thread_buffer = get_thread_buffer();
+
+    // Only the calling thread writes to its buffer
+    uint64_t write_count = thread_buffer.m_write_count.load(std::memory_order_relaxed);
+
+    Zone &zone = thread_buffer.m_zones[write_count & (k_ring_capacity - 1)];
+    zone.m_name.store(name, std::memory_order_relaxed);
+    zone.m_begin_ns.store(begin_ns, std::memory_order_relaxed);
+    zone.m_end_ns.store(end_ns, std::memory_order_relaxed);
+
+    thread_buffer.m_write_count.store(write_count + 1, std::memory_order_release);
+}
+
+void Profiler::set_thread_name(std::string const &thread_name)
+{
+    ThreadBuffer &thread_buffer = get_thread_buffer();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    thread_buffer.m_thread_name = thread_name;
+}
+
+void Profiler::write_chrome_trace(std::ostream &stream)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    stream << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    stream << std::fixed << std::setprecision(3);
+
+    bool first_event = true;
+    auto begin_event = [&]()
+    {
+        if (!first_event) stream << ",\n";
+        first_event = false;
+    };
+
+    struct ZoneCopy
+    {
+        char const *m_name;
+        uint64_t m_begin_ns;
+        uint64_t m_end_ns;
+    };
+    std::vector<ZoneCopy> zones;
+
+    for (std::shared_ptr<ThreadBuffer> const &thread_buffer : m_thread_buffers)
+    {
+        begin_event();
+        stream << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread_buffer->m_thread_id << ", \"args\": {\"name\": ";
+        write_json_string(stream, thread_buffer->m_thread_name.c_str());
+        stream << "}}";
+
+        // Copy the ring, then drop the zones the thread overwrote meanwhile (the slot of the zone being written included)
+        uint64_t write_count = thread_buffer->m_write_count.load(std::memory_order_acquire);
+        uint64_t first_index = write_count > k_ring_capacity ? write_count - k_ring_capacity : 0;
+
+        zones.clear();
+        for (uint64_t index = first_index; index < write_count; index++)
+        {
+            Zone const &zone = thread_buffer->m_zones[index & (k_ring_capacity - 1)];
+            zones.push_back(ZoneCopy{
+                .m_name = zone.m_name.load(std::memory_order_relaxed),
+                .m_begin_ns = zone.m_begin_ns.load(std::memory_order_relaxed),
+                .m_end_ns = zone.m_end_ns.load(std::memory_order_relaxed),
+            });
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t write_count_after = thread_buffer->m_write_count.load(std::memory_order_relaxed);
+        uint64_t first_valid_index = write_count_after + 1 > k_ring_capacity ? write_count_after + 1 - k_ring_capacity : 0;
+
+        for (uint64_t index = std::max(first_index, first_valid_index); index < write_count; index++)
+        {
+            ZoneCopy const &zone = zones[index - first_index];
+            uint64_t begin_ns = std::max(zone.m_begin_ns, m_started_at_ns);  // A zone begun before the profiler creation is clamped
+
+            begin_event();
+            stream << "{\"name\": ";
+            write_json_string(stream, zone.m_name);
+            stream << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << thread_buffer->m_thread_id;
+            stream << ", \"ts\": " << double(begin_ns - m_started_at_ns) / 1000.0;
+            stream << ", \"dur\": " << double(std::max(zone.m_end_ns, begin_ns) - begin_ns) / 1000.0 << "}";
+        }
+    }
+
+    stream << "\n]}\n";
+}
+
+uint64_t Profiler::get_now_ns()
+{
+    using namespace std::chrono;
+
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+Profiler::ThreadBuffer &Profiler::get_thread_buffer()
+{
+    for (auto const &[profiler_id, thread_buffer] : thread_buffers)
+    {
+        if (profiler_id == m_id) return *static_cast<ThreadBuffer *>(thread_buffer);
+    }
+
+    auto thread_buffer = std::make_shared<ThreadBuffer>();
+    thread_buffer->m_zones = std::make_unique<Zone[]>(k_ring_capacity);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        thread_buffer->m_thread_id = uint32_t(m_thread_buffers.size());
+        thread_buffer->m_thread_name = "Thread " + std::to_string(thread_buffer->m_thread_id);
+        m_thread_buffers.push_back(thread_buffer);
+    }
+
+    thread_buffers.emplace_back(m_id, thread_buffer.get());
+
+    return *thread_buffer;
+}
+
+Profiler &explo::profiler()
+{
+    static Profiler profiler{};
+    return profiler;
+}
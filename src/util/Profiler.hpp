@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace explo
+{
+    /// Records scoped zones (e.g. a frame, a chunk generation stage) per thread, to be viewed on a timeline across threads: the zones are
+    /// written as the complete events of a Chrome trace (to open with chrome://tracing or ui.perfetto.dev).
+    ///
+    /// Every thread writes its zones into its own ring buffer, without locking. Only the latest zones (up to k_ring_capacity) per thread are kept,
+    /// so that recording can stay on and the trace be dumped on demand (e.g. right after a stutter). The zones are recorded through
+    /// PROFILE_SCOPE, that is compiled out unless EXPLO_PROFILER is defined.
+    class Profiler
+    {
+    public:
+        static constexpr size_t k_ring_capacity = 16384;  ///< Per thread, a power of 2
+
+    private:
+        struct Zone
+        {
+            // Atomics as the zones can be overwritten while being dumped (relaxed, as plain stores)
+            std::atomic<char const *> m_name;
+            std::atomic<uint64_t> m_begin_ns;
+            std::atomic<uint64_t> m_end_ns;
+        };
+
+        struct ThreadBuffer
+        {
+            uint32_t m_thread_id;
+            std::string m_thread_name;  ///< Guarded by the profiler mutex
+            std::unique_ptr<Zone[]> m_zones;
+            std::atomic<uint64_t> m_write_count = 0;  ///< The zones written so far, the last k_ring_capacity are in the ring
+        };
+
+        uint64_t m_id;  ///< Unique across the profiler instances, identifies the thread buffers cached by the threads
+        uint64_t m_started_at_ns;
+
+        std::mutex m_mutex;  ///< Held while registering a thread and while dumping
+        std::vector<std::shared_ptr<ThreadBuffer>> m_thread_buffers;  ///< Outlive their thread, so that the zones are dumped anyway
+
+    public:
+        explicit Profiler();
+        ~Profiler();
+
+        /// Records a zone on the calling thread. The name must outlive the profiler (e.g. a string literal).
+        void record_zone(char const *name, uint64_t begin_ns, uint64_t end_ns);
+
+        /// Names the calling thread within the trace.
+        void set_thread_name(std::string const &thread_name);
+
+        /// Writes the zones recorded by every thread as a Chrome trace (JSON), the timestamps being relative to the profiler creation.
+        void write_chrome_trace(std::ostream &stream);
+
+        static uint64_t get_now_ns();
+
+    private:
+        /// Returns the ring buffer of the calling thread, registering it on the first call.
+        ThreadBuffer &get_thread_buffer();
+    };
+
+    /// The profiler of the engine.
+    Profiler &profiler();
+
+    /// Records the zone from its construction to its destruction.
+    class ProfileScope
+    {
+    private:
+        Profiler &m_profiler;  ///< Initialized first: the profiler must exist before the zone begins, or the zone would precede it
+        char const *m_name;
+        uint64_t m_begin_ns;
+
+    public:
+        explicit ProfileScope(char const *name) :
+            m_profiler(profiler()),
+            m_name(name),
+            m_begin_ns(Profiler::get_now_ns())
+        {
+        }
+
+        ~ProfileScope() { m_profiler.record_zone(m_name, m_begin_ns, Profiler::get_now_ns()); }
+    };
+}  // namespace explo
+
+#define EXPLO_PROFILER_CONCAT_(a, b) a##b
+#define EXPLO_PROFILER_CONCAT(a, b) EXPLO_PROFILER_CONCAT_(a, b)
+
+#ifdef EXPLO_PROFILER
+#define PROFILE_SCOPE(name) explo::ProfileScope EXPLO_PROFILER_CONCAT(profile_scope_, __LINE__)(name)
+#define PROFILE_THREAD_NAME(thread_name) explo::profiler().set_thread_name(thread_name)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_THREAD_NAME(thread_name)
+#endif
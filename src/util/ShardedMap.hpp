@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace explo
+{
+    /// A thread-safe hash map split into shards, each with its own lock: concurrent lookups and writes only contend when they fall in the
+    /// same shard. The values are returned by copy (e.g. shared_ptr), never by reference, as they could be erased right after.
+    template <typename _KeyT, typename _ValueT, typename _HashT = std::hash<_KeyT>, size_t _shard_count = 64>
+    class ShardedMap
+    {
+        static_assert(std::has_single_bit(_shard_count), "The shard count must be a power of two");
+
+    private:
+        struct alignas(64) Shard
+        {
+            mutable std::mutex m_mutex;
+            std::unordered_map<_KeyT, _ValueT, _HashT> m_map;
+        };
+
+        std::array<Shard, _shard_count> m_shards;
+        std::atomic<size_t> m_size = 0;
+
+    public:
+        explicit ShardedMap() = default;
+        ~ShardedMap() = default;
+
+        ShardedMap(ShardedMap const &) = delete;
+        ShardedMap &operator=(ShardedMap const &) = delete;
+
+        size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+        bool contains(_KeyT const &key) const
+        {
+            Shard const &shard = get_shard(key);
+            std::lock_guard<std::mutex> lock(shard.m_mutex);
+            return shard.m_map.contains(key);
+        }
+
+        /// Returns a copy of the value mapped to the key, if any.
+        std::optional<_ValueT> find(_KeyT const &key) const
+        {
+            Shard const &shard = get_shard(key);
+            std::lock_guard<std::mutex> lock(shard.m_mutex);
+
+            auto it = shard.m_map.find(key);
+            if (it == shard.m_map.end()) return std::nullopt;
+            return it->second;
+        }
+
+        /// Maps the value to the key, unless the key is already mapped.
+        /// \return A copy of the value mapped to the key and whether it has been inserted.
+        std::pair<_ValueT, bool> emplace(_KeyT const &key, _ValueT value)
+        {
+            Shard &shard = get_shard(key);
+            std::lock_guard<std::mutex> lock(shard.m_mutex);
+
+            auto [it, inserted] = shard.m_map.emplace(key, std::move(value));
+            if (inserted) m_size.fetch_add(1, std::memory_order_relaxed);
+            return {it->second, inserted};
+        }
+
+        /// Removes the key and returns the value it was mapped to, if any (so that it's destroyed by the caller, out of the lock).
+        std::optional<_ValueT> extract(_KeyT const &key)
+        {
+            Shard &shard = get_shard(key);
+            std::lock_guard<std::mutex> lock(shard.m_mutex);
+
+            auto it = shard.m_map.find(key);
+            if (it == shard.m_map.end()) return std::nullopt;
+
+            std::optional<_ValueT> value(std::move(it->second));
+            shard.m_map.erase(it);
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            return value;
+        }
+
+        /// Calls the function for every entry, locking a shard at a time: the entries inserted or removed meanwhile may be missed. The
+        /// function must not access the map.
+        template <typename _FunctionT>
+        void for_each(_FunctionT const &function) const
+        {
+            for (Shard const &shard : m_shards)
+            {
+                std::lock_guard<std::mutex> lock(shard.m_mutex);
+                for (auto const &[key, value] : shard.m_map) function(key, value);
+            }
+        }
+
+    private:
+        /// The shard is picked from the high bits of the hash multiplied by 2^64/phi (Fibonacci hashing), so that a poor hash of the
+        /// coordinates still spreads over the shards.
+        static size_t get_shard_index(_KeyT const &key)
+        {
+            uint64_t hash = uint64_t(_HashT{}(key)) * 0x9E3779B97F4A7C15ull;
+            if constexpr (_shard_count == 1) return 0;
+            else return size_t(hash >> (64 - std::countr_zero(_shard_count)));
+        }
+
+        Shard &get_shard(_KeyT const &key) { return m_shards[get_shard_index(key)]; }
+        Shard const &get_shard(_KeyT const &key) const { return m_shards[get_shard_index(key)]; }
+    };
+}  // namespace explo
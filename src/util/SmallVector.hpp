@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace explo
+{
+    /// A vector storing up to _inline_capacity elements within itself, without allocating. Once exceeded, all of the elements are moved
+    /// to the heap (kept contiguous); clear() brings it back to the inline storage. The elements must be default constructible.
+    template <typename _T, size_t _inline_capacity>
+    class SmallVector
+    {
+    private:
+        std::array<_T, _inline_capacity> m_inline_elements{};
+        size_t m_inline_size = 0;
+
+        std::vector<_T> m_heap_elements;  ///< Holds all of the elements once the inline capacity is exceeded, empty otherwise
+
+    public:
+        explicit SmallVector() = default;
+        ~SmallVector() = default;
+
+        bool is_inline() const { return m_heap_elements.empty(); }
+
+        _T *data() { return is_inline() ? m_inline_elements.data() : m_heap_elements.data(); }
+        _T const *data() const { return is_inline() ? m_inline_elements.data() : m_heap_elements.data(); }
+
+        size_t size() const { return is_inline() ? m_inline_size : m_heap_elements.size(); }
+        bool empty() const { return size() == 0; }
+
+        _T *begin() { return data(); }
+        _T *end() { return data() + size(); }
+        _T const *begin() const { return data(); }
+        _T const *end() const { return data() + size(); }
+
+        _T &operator[](size_t i) { return data()[i]; }
+        _T const &operator[](size_t i) const { return data()[i]; }
+
+        void push_back(_T element)
+        {
+            if (is_inline() && m_inline_size < _inline_capacity)
+            {
+                m_inline_elements[m_inline_size++] = std::move(element);
+                return;
+            }
+
+            if (is_inline())
+            {
+                // Spill the inline elements to the heap
+                m_heap_elements.reserve(_inline_capacity * 2);
+                for (size_t i = 0; i < m_inline_size; i++) m_heap_elements.push_back(std::exchange(m_inline_elements[i], _T{}));
+                m_inline_size = 0;
+            }
+
+            m_heap_elements.push_back(std::move(element));
+        }
+
+        void clear()
+        {
+            for (size_t i = 0; i < m_inline_size; i++) m_inline_elements[i] = _T{};
+            m_inline_size = 0;
+
+            m_heap_elements.clear();
+        }
+    };
+}  // namespace explo
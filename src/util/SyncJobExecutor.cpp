@@ -2,33 +2,57 @@
 
 #include <cassert>
 
+#include "Profiler.hpp"
+#include "misc.hpp"
+
 using namespace explo;
 
 SyncJobExecutor::SyncJobExecutor() {}
 
 size_t SyncJobExecutor::get_job_count() const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     return m_jobs.size();
 }
 
-void SyncJobExecutor::enqueue_job(JobT const &job)
+void SyncJobExecutor::enqueue_job(JobT job)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    m_jobs.push_back(job);
+    m_jobs.push(std::move(job));
 }
 
 void SyncJobExecutor::process()
 {
-    // Iterates for the jobs that were enqueued just before process() was called. This not to iterate jobs that could be
-    // enqueued by a job itself
-    std::deque<JobT> jobs;
+    process(Budget{});
+}
+
+size_t SyncJobExecutor::process(Budget const &budget)
+{
+    PROFILE_SCOPE("SyncJobExecutor::process");
+
+    uint64_t started_at = get_steady_nanos();
+
+    // Iterates for the jobs that were enqueued just before process() was called (the ones carried over being the first). This not to
+    // iterate jobs that could be enqueued by a job itself
+    size_t job_count = m_jobs.size();
+    m_queue_depth_stats.push_sample(job_count);
+
+    size_t processed_count = 0;
+    while (processed_count < job_count)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        jobs = std::move(m_jobs);
+        if (processed_count > 0)
+        {
+            if (budget.m_max_job_count > 0 && processed_count >= budget.m_max_job_count) break;
+            if (budget.m_max_time_ns > 0 && get_steady_nanos() - started_at >= budget.m_max_time_ns) break;
+        }
+
+        std::optional<JobT> job = m_jobs.pop();
+        if (!job) break;  // A producer is in the middle of a push, the job will be processed by the next call
+
+        (*job)();
+
+        processed_count++;
     }
 
-    for (JobT const &job : jobs) job();
+    m_process_stats.push_elapsed_time(get_steady_nanos() - started_at);
+
+    return processed_count;
 }
@@ -1,29 +1,52 @@
 #pragma once
 
-#include <deque>
-#include <functional>
-#include <mutex>
+#include <cstdint>
+
+#include "Job.hpp"
+#include "MpscQueue.hpp"
+#include "profile_stats.hpp"
 
 namespace explo
 {
+    /// Runs the jobs posted by any thread on the thread calling process() (e.g. the main thread). Posting never blocks.
     class SyncJobExecutor
     {
     public:
-        using JobT = std::function<void()>;
+        using JobT = Job;
+
+        /// Limits the work done by a single process() call. A zero field means no limit. At least one job is processed per call so that
+        /// the queue always makes progress.
+        struct Budget
+        {
+            uint64_t m_max_time_ns = 0;
+            size_t m_max_job_count = 0;
+        };
 
     private:
-        std::deque<JobT> m_jobs;
+        MpscQueue<JobT> m_jobs;
 
-        mutable std::mutex m_mutex;
+        // Only accessed by the processing thread
+        profile_stats m_process_stats;      ///< The time spent per process() call
+        profile_stats m_queue_depth_stats;  ///< The jobs waiting when process() is called
 
     public:
         explicit SyncJobExecutor();
         ~SyncJobExecutor() = default;
 
+        /// Returns the number of jobs waiting to be processed, including the ones carried over by a budgeted process().
         size_t get_job_count() const;
 
-        void enqueue_job(JobT const &job);
+        void enqueue_job(JobT job);
 
+        /// Processes the jobs enqueued before the call.
         void process();
+
+        /// Processes the jobs enqueued before the call, in order, until the budget is exceeded. The remaining jobs are processed first
+        /// by the next call.
+        /// \return The number of jobs processed.
+        size_t process(Budget const &budget);
+
+        profile_stats const &get_process_stats() const { return m_process_stats; }
+        profile_stats const &get_queue_depth_stats() const { return m_queue_depth_stats; }
     };
 }  // namespace explo
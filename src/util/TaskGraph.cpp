@@ -0,0 +1,110 @@
+#include "TaskGraph.hpp"
+
+using namespace explo;
+
+// ------------------------------------------------------------------------------------------------
+// Task
+// ------------------------------------------------------------------------------------------------
+
+Task::Task(JobT job, std::shared_ptr<JobToken> token) :
+    m_job(std::move(job)),
+    m_token(std::move(token))
+{
+}
+
+Task::~Task() {}
+
+void Task::precede(std::shared_ptr<Task> const &successor)
+{
+    std::lock_guard<std::mutex> lock(m_successors_mutex);
+    if (m_done) return;
+
+    successor->m_pending_count++;
+    m_successors.push_back(successor);
+}
+
+void Task::dispatch(ThreadPool &thread_pool)
+{
+    m_thread_pool = &thread_pool;
+
+    // Release the dispatch hold
+    if (m_pending_count.fetch_sub(1) == 1) enqueue();
+}
+
+void Task::enqueue()
+{
+    // Not dropped when cancelled: the task must still release its successors
+    m_thread_pool->enqueue_job(
+        [task = shared_from_this()]()
+        {
+            task->run();
+        },
+        m_token,
+        false
+    );
+}
+
+void Task::run()
+{
+    std::shared_ptr<Task> task = shared_from_this();
+    while (task)
+    {
+        if (!task->m_token || !task->m_token->is_cancelled()) task->m_job();
+        task->m_job = nullptr;  // Release the captures now, the task could be referenced for long by other graphs
+
+        // Continue with the first ready successor on this worker, it's likely to use the data the task just produced
+        task = task->complete();
+    }
+}
+
+std::shared_ptr<Task> Task::complete()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_successors_mutex);
+        m_done = true;
+    }
+
+    // Done: no successor can be added anymore, they can be read without locking
+    std::shared_ptr<Task> next_task;
+    for (std::shared_ptr<Task> &successor : m_successors)
+    {
+        if (successor->m_pending_count.fetch_sub(1) != 1) continue;  // Still waiting for other tasks
+
+        if (!next_task) next_task = std::move(successor);
+        else successor->enqueue();
+    }
+
+    m_successors.clear();
+    return next_task;
+}
+
+// ------------------------------------------------------------------------------------------------
+// TaskGraph
+// ------------------------------------------------------------------------------------------------
+
+TaskGraph::TaskGraph(std::shared_ptr<JobToken> token) :
+    m_token(std::move(token))
+{
+}
+
+TaskGraph::~TaskGraph() {}
+
+std::shared_ptr<Task> TaskGraph::add(JobT job, std::initializer_list<std::shared_ptr<Task>> predecessors)
+{
+    return add(std::move(job), std::span(predecessors.begin(), predecessors.end()));
+}
+
+std::shared_ptr<Task> TaskGraph::add(JobT job, std::span<std::shared_ptr<Task> const> predecessors)
+{
+    std::shared_ptr<Task> task = std::allocate_shared<Task>(BlockPoolAllocator<Task>(), std::move(job), m_token);
+    for (std::shared_ptr<Task> const &predecessor : predecessors) predecessor->precede(task);
+
+    m_tasks.push_back(task);
+    return task;
+}
+
+void TaskGraph::dispatch(ThreadPool &thread_pool)
+{
+    for (std::shared_ptr<Task> const &task : m_tasks) task->dispatch(thread_pool);
+    m_tasks.clear();
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <span>
+
+#include "Job.hpp"
+#include "JobToken.hpp"
+#include "SmallVector.hpp"
+#include "ThreadPool.hpp"
+
+namespace explo
+{
+    /// A job run once all of its predecessors are done. Tasks are shared so that a graph can depend on the tasks of other graphs
+    /// (e.g. the surface of a chunk waiting for the volume of its neighbours). They're allocated from the BlockPool and store their
+    /// successors inline: once the pools are warm, building and running a graph doesn't allocate.
+    class Task : public std::enable_shared_from_this<Task>
+    {
+        friend class TaskGraph;
+
+    public:
+        using JobT = Job;
+
+        /// Enough for a chunk volume task, preceding the surface of the chunk and of its 6 neighbours.
+        static constexpr size_t k_inline_successor_count = 7;
+
+    private:
+        JobT m_job;
+        std::shared_ptr<JobToken> m_token;
+        ThreadPool *m_thread_pool = nullptr;
+
+        /// The predecessors not done yet, plus one until the task is dispatched: the task is enqueued when it reaches zero.
+        std::atomic<uint32_t> m_pending_count = 1;
+
+        std::mutex m_successors_mutex;
+        SmallVector<std::shared_ptr<Task>, k_inline_successor_count> m_successors;
+        std::atomic<bool> m_done = false;
+
+    public:
+        explicit Task(JobT job, std::shared_ptr<JobToken> token);
+        ~Task();
+
+        /// Whether the task has run (or has been skipped because its token was cancelled) and has released its successors.
+        bool is_done() const { return m_done; }
+
+        /// Makes the successor wait for this task; does nothing if the task is already done. Must be called before the successor is
+        /// dispatched.
+        void precede(std::shared_ptr<Task> const &successor);
+
+    private:
+        void dispatch(ThreadPool &thread_pool);
+        void enqueue();
+
+        /// Runs the task, then the successors it made ready: the first one inline (on the same worker), the others are enqueued.
+        void run();
+
+        /// Marks the task as done and releases its successors: the ones that aren't waiting for any other task anymore are enqueued, but
+        /// the first one that is returned instead.
+        std::shared_ptr<Task> complete();
+    };
+
+    /// Builds a set of tasks and their dependencies (fan-out, fan-in), then dispatches them on a thread pool.
+    ///
+    /// The tasks are enqueued with the graph token, hence ordered by its priority. A cancelled task doesn't run its job but still
+    /// releases its successors, which could belong to another graph.
+    class TaskGraph
+    {
+    public:
+        using JobT = Task::JobT;
+
+        static constexpr size_t k_inline_task_count = 4;
+
+    private:
+        std::shared_ptr<JobToken> m_token;
+        SmallVector<std::shared_ptr<Task>, k_inline_task_count> m_tasks;
+
+    public:
+        explicit TaskGraph(std::shared_ptr<JobToken> token = nullptr);
+        ~TaskGraph();
+
+        /// Adds a task, optionally depending on the given ones.
+        std::shared_ptr<Task> add(JobT job, std::initializer_list<std::shared_ptr<Task>> predecessors = {});
+        std::shared_ptr<Task> add(JobT job, std::span<std::shared_ptr<Task> const> predecessors);
+
+        /// Dispatches the tasks on the thread pool. The graph can be discarded afterwards.
+        void dispatch(ThreadPool &thread_pool);
+    };
+}  // namespace explo
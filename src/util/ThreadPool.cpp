@@ -1,11 +1,38 @@
 #include "ThreadPool.hpp"
 
+#include <algorithm>
+#include <string>
+
+#include "Profiler.hpp"
 #include "log.hpp"
 
 using namespace explo;
 
+namespace
+{
+    // Identifies the workers, so that the jobs they enqueue go to their own deque
+    thread_local ThreadPool const *current_thread_pool = nullptr;
+    thread_local int current_thread_id = -1;
+
+    uint32_t xorshift32(uint32_t &state)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+}  // namespace
+
 ThreadPool::ThreadPool(size_t num_threads)
 {
+    // The workers must all exist before any thread starts stealing from them
+    m_workers.reserve(num_threads);
+    for (size_t thread_id = 0; thread_id < num_threads; thread_id++)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+        m_workers.back()->m_random_state = uint32_t(thread_id) * 0x9E3779B9u + 1;
+    }
+
     m_threads.reserve(num_threads);
 
     for (size_t thread_id = 0; thread_id < num_threads; thread_id++)
@@ -26,14 +53,20 @@ ThreadPool::ThreadPool() :
 
 ThreadPool::~ThreadPool()
 {
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_should_terminate = true;
-    }
+    m_should_terminate = true;
 
-    m_condition_variable.notify_all();
+    for (std::unique_ptr<Worker> &worker : m_workers) worker->m_wake_semaphore.release();
 
     for (std::thread &thread : m_threads) thread.join();
+
+    // Release the jobs that were never run
+    for (std::unique_ptr<Worker> &worker : m_workers)
+    {
+        while (JobT *job = worker->m_jobs.pop()) destroy_job(job);
+    }
+
+    while (JobT *job = pop_injected_job()) destroy_job(job);
+    for (PrioritizedJob &prioritized_job : m_prioritized_jobs) destroy_job(prioritized_job.m_job);
 }
 
 size_t ThreadPool::get_thread_count() const
@@ -43,78 +76,266 @@ size_t ThreadPool::get_thread_count() const
 
 bool ThreadPool::is_thread_working(size_t thread_id)
 {
-    // Here we use the same mutex used to synchronize the queue. We could improve it by locking on a different mutex
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    return m_thread_working.test(thread_id);
+    return m_workers.at(thread_id)->m_working.load(std::memory_order_relaxed);
 }
 
 size_t ThreadPool::get_job_count()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    int64_t job_count = m_job_count.load(std::memory_order_relaxed);
+    return job_count > 0 ? size_t(job_count) : 0;
+}
+
+size_t ThreadPool::enqueue_job(JobT job)
+{
+    size_t job_id = m_next_job_id.fetch_add(1, std::memory_order_relaxed);
+
+    JobT *job_ptr = create_job(std::move(job));
+
+    // Accounted before being pushed so that the count never goes negative when the job is taken right away
+    m_job_count.fetch_add(1);
+
+    int thread_id = get_current_thread_id();
+    if (thread_id >= 0)
+    {
+        m_workers[thread_id]->m_jobs.push(job_ptr);
+    }
+    else
+    {
+        push_injected_job(job_ptr);
+    }
+
+    notify_job_enqueued();
 
-    return m_jobs.size();
+    return job_id;
 }
 
-size_t ThreadPool::enqueue_job(std::function<void()> const &job)
+size_t ThreadPool::enqueue_job(JobT job, std::shared_ptr<JobToken> token, bool drop_if_cancelled)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!token) return enqueue_job(std::move(job));
+
+    size_t job_id = m_next_job_id.fetch_add(1, std::memory_order_relaxed);
 
-    size_t job_id = m_next_job_id++;
-    m_jobs.push_back(job);
+    m_job_count.fetch_add(1);
 
-    m_condition_variable.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(m_priority_mutex);
+
+        float priority = token->get_priority();
+        m_prioritized_jobs.push_back(PrioritizedJob{
+            .m_job = create_job(std::move(job)),
+            .m_token = std::move(token),
+            .m_priority = priority,
+            .m_drop_if_cancelled = drop_if_cancelled,
+        });
+        std::push_heap(m_prioritized_jobs.begin(), m_prioritized_jobs.end(), PrioritizedJob::is_lower_priority);
+    }
+
+    notify_job_enqueued();
 
     return job_id;
 }
 
-void ThreadPool::drop_job(size_t job_id)
+void ThreadPool::update_priorities()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_jobs.erase(m_jobs.begin() + job_id);
+    size_t dropped_count = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_priority_mutex);
+
+        std::erase_if(
+            m_prioritized_jobs,
+            [&](PrioritizedJob &prioritized_job)
+            {
+                if (!prioritized_job.m_drop_if_cancelled || !prioritized_job.m_token->is_cancelled()) return false;
+
+                destroy_job(prioritized_job.m_job);
+                dropped_count++;
+                return true;
+            }
+        );
+
+        for (PrioritizedJob &prioritized_job : m_prioritized_jobs) prioritized_job.m_priority = prioritized_job.m_token->get_priority();
+        std::make_heap(m_prioritized_jobs.begin(), m_prioritized_jobs.end(), PrioritizedJob::is_lower_priority);
+    }
+
+    for (size_t i = 0; i < dropped_count; i++) notify_job_taken();
 }
 
 void ThreadPool::drain()
 {
-    std::unique_lock<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(m_idle_mutex);
     m_drained_condition.wait(
         lock,
         [this]
         {
-            return m_jobs.empty();
+            return m_job_count.load() <= 0;
         }
     );
 }
 
+int ThreadPool::get_current_thread_id() const
+{
+    return current_thread_pool == this ? current_thread_id : -1;
+}
+
+ThreadPool::JobT *ThreadPool::take_job(size_t thread_id)
+{
+    if (JobT *job = m_workers[thread_id]->m_jobs.pop()) return job;
+
+    if (JobT *job = pop_injected_job()) return job;
+
+    if (JobT *job = take_prioritized_job()) return job;
+
+    return steal_job(thread_id);
+}
+
+ThreadPool::JobT *ThreadPool::take_prioritized_job()
+{
+    std::lock_guard<std::mutex> lock(m_priority_mutex);
+
+    while (!m_prioritized_jobs.empty())
+    {
+        std::pop_heap(m_prioritized_jobs.begin(), m_prioritized_jobs.end(), PrioritizedJob::is_lower_priority);
+        PrioritizedJob prioritized_job = std::move(m_prioritized_jobs.back());
+        m_prioritized_jobs.pop_back();
+
+        if (!prioritized_job.m_drop_if_cancelled || !prioritized_job.m_token->is_cancelled()) return prioritized_job.m_job;
+
+        // Dropped: accounted as taken without being run
+        destroy_job(prioritized_job.m_job);
+        notify_job_taken();
+    }
+    return nullptr;
+}
+
+ThreadPool::JobT *ThreadPool::steal_job(size_t thread_id)
+{
+    // Start from a random victim so that the thieves don't all contend on the same deque
+    size_t worker_count = m_workers.size();
+    size_t first_victim = xorshift32(m_workers[thread_id]->m_random_state) % worker_count;
+
+    for (size_t i = 0; i < worker_count; i++)
+    {
+        size_t victim = (first_victim + i) % worker_count;
+        if (victim == thread_id) continue;
+
+        if (JobT *job = m_workers[victim]->m_jobs.steal()) return job;
+    }
+    return nullptr;
+}
+
+ThreadPool::JobT *ThreadPool::create_job(JobT &&job)
+{
+    return new (BlockPool::allocate(sizeof(JobT))) JobT(std::move(job));
+}
+
+void ThreadPool::destroy_job(JobT *job)
+{
+    job->~JobT();
+    BlockPool::deallocate(job, sizeof(JobT));
+}
+
+void ThreadPool::push_injected_job(JobT *job)
+{
+    std::lock_guard<std::mutex> lock(m_injection_mutex);
+
+    if (m_injected_job_count == m_injected_jobs.size())
+    {
+        // Full: unroll the ring into a buffer twice as large
+        std::vector<JobT *> injected_jobs(m_injected_jobs.size() * 2);
+        for (size_t i = 0; i < m_injected_job_count; i++)
+            injected_jobs[i] = m_injected_jobs[(m_injected_job_head + i) % m_injected_jobs.size()];
+
+        m_injected_jobs = std::move(injected_jobs);
+        m_injected_job_head = 0;
+    }
+
+    m_injected_jobs[(m_injected_job_head + m_injected_job_count) % m_injected_jobs.size()] = job;
+    m_injected_job_count++;
+}
+
+ThreadPool::JobT *ThreadPool::pop_injected_job()
+{
+    std::lock_guard<std::mutex> lock(m_injection_mutex);
+
+    if (m_injected_job_count == 0) return nullptr;
+
+    JobT *job = m_injected_jobs[m_injected_job_head];
+    m_injected_job_head = (m_injected_job_head + 1) % m_injected_jobs.size();
+    m_injected_job_count--;
+    return job;
+}
+
+void ThreadPool::notify_job_enqueued()
+{
+    // The idle count is incremented before the job count is checked by the worker going to sleep (both seq_cst), therefore either the
+    // worker sees the job or we see the worker
+    if (m_idle_worker_count.load() == 0) return;
+
+    size_t thread_id;
+    {
+        std::lock_guard<std::mutex> lock(m_idle_mutex);
+        if (m_idle_workers.empty()) return;  // Woken by another enqueue meanwhile
+
+        thread_id = m_idle_workers.back();
+        m_idle_workers.pop_back();
+        m_idle_worker_count--;
+    }
+
+    m_workers[thread_id]->m_wake_semaphore.release();
+}
+
+void ThreadPool::notify_job_taken()
+{
+    if (m_job_count.fetch_sub(1) == 1)
+    {
+        std::lock_guard<std::mutex> lock(m_idle_mutex);
+        m_drained_condition.notify_all();
+    }
+}
+
 void ThreadPool::thread_loop(size_t thread_id)
 {
-    while (true)
+    current_thread_pool = this;
+    current_thread_id = int(thread_id);
+
+    PROFILE_THREAD_NAME("Worker " + std::to_string(thread_id));
+
+    Worker &worker = *m_workers[thread_id];
+
+    while (!m_should_terminate.load(std::memory_order_relaxed))
     {
-        std::function<void()> job;
+        if (JobT *job = take_job(thread_id))
         {
-            std::unique_lock<std::mutex> lock(m_mutex);
+            notify_job_taken();
 
-            m_thread_working[thread_id] = false;
+            worker.m_working.store(true, std::memory_order_relaxed);
+            (*job)();
+            destroy_job(job);
+            worker.m_working.store(false, std::memory_order_relaxed);
 
-            // If after executing the job we find out that there are no jobs left, we signal that the jobs queue is drained
-            if (m_jobs.empty()) m_drained_condition.notify_all();
+            continue;
+        }
 
-            m_condition_variable.wait(
-                lock,
-                [this]
-                {
-                    return m_jobs.size() > 0;
-                }
-            );
+        wait_for_job(thread_id);
+    }
+}
 
-            if (m_should_terminate) return;
+void ThreadPool::wait_for_job(size_t thread_id)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_idle_mutex);
 
-            job = m_jobs.front();
-            m_jobs.pop_front();
+        m_idle_workers.push_back(thread_id);
+        m_idle_worker_count++;
 
-            m_thread_working[thread_id] = true;
+        if (m_job_count.load() > 0)
+        {
+            // A job was enqueued meanwhile (possibly not pushed yet): don't sleep
+            m_idle_workers.pop_back();
+            m_idle_worker_count--;
+            return;
         }
-
-        job();
     }
+
+    m_workers[thread_id]->m_wake_semaphore.acquire();
 }
@@ -1,33 +1,74 @@
 #pragma once
 
-#include <bitset>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
-#include <deque>
-#include <functional>
+#include <memory>
+#include <mutex>
+#include <semaphore>
 #include <thread>
 #include <vector>
 
+#include "Job.hpp"
+#include "JobToken.hpp"
+#include "WorkStealingDeque.hpp"
+
 namespace explo
 {
+    /// A work-stealing thread pool: every worker owns a deque where the jobs it enqueues are pushed, and takes the work of the
+    /// others when it runs out of jobs. The jobs enqueued from outside of the pool go through a shared injection queue.
+    ///
+    /// The jobs enqueued with a JobToken are background work (e.g. the chunk generation): they go through a shared priority queue and
+    /// are only taken once the worker's own deque and the injection queue are empty.
     class ThreadPool
     {
     public:
-        inline static constexpr size_t k_max_threads = 32;
+        using JobT = Job;
 
     private:
+        struct Worker
+        {
+            WorkStealingDeque<JobT *> m_jobs;
+            std::atomic<bool> m_working = false;
+            uint32_t m_random_state;  ///< Used to pick the victim of the steals
+            std::counting_semaphore<> m_wake_semaphore{0};  ///< Can be released more than once on termination
+        };
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
         std::vector<std::thread> m_threads;
-        std::deque<std::function<void()>> m_jobs;
-        std::condition_variable m_condition_variable;
-        std::condition_variable m_drained_condition;
 
-        std::mutex m_mutex;
+        // The jobs enqueued from a thread that isn't a worker of the pool, a ring buffer that only grows (a std::deque would allocate and
+        // release its blocks as the jobs flow)
+        std::mutex m_injection_mutex;
+        std::vector<JobT *> m_injected_jobs = std::vector<JobT *>(64);
+        size_t m_injected_job_head = 0;
+        size_t m_injected_job_count = 0;
 
-        bool m_should_terminate = false;
+        struct PrioritizedJob
+        {
+            JobT *m_job;
+            std::shared_ptr<JobToken> m_token;
+            float m_priority;  ///< The token priority when the job was enqueued or update_priorities() was last called
+            bool m_drop_if_cancelled;
 
-        size_t m_next_job_id = 0;
+            /// The std heap functions put the greatest on top: the lowest priority value must be the greatest.
+            static bool is_lower_priority(PrioritizedJob const &a, PrioritizedJob const &b) { return a.m_priority > b.m_priority; }
+        };
 
-        std::bitset<k_max_threads> m_thread_working;
+        std::mutex m_priority_mutex;
+        std::vector<PrioritizedJob> m_prioritized_jobs;  ///< A heap, lowest priority on top
+
+        std::atomic<int64_t> m_job_count = 0;  ///< The number of jobs enqueued but not taken yet
+
+        // A job enqueue wakes exactly one of the sleeping workers, and doesn't lock anything if none is sleeping
+        std::mutex m_idle_mutex;
+        std::vector<size_t> m_idle_workers;
+        std::atomic<size_t> m_idle_worker_count = 0;
+        std::condition_variable m_drained_condition;
+
+        std::atomic<bool> m_should_terminate = false;
+
+        std::atomic<size_t> m_next_job_id = 0;
 
     public:
         explicit ThreadPool(size_t num_threads);
@@ -38,12 +79,44 @@ namespace explo
         bool is_thread_working(size_t thread_id);
 
         size_t get_job_count();
-        size_t enqueue_job(std::function<void()> const &job);
-        void drop_job(size_t job_id);
 
+        /// Enqueues the job. If called from a worker of the pool, the job is pushed on its own deque and is likely to be run by the same
+        /// worker (unless stolen), otherwise it's pushed on the injection queue.
+        size_t enqueue_job(JobT job);
+
+        /// Enqueues the job on the priority queue. Unless drop_if_cancelled is unset, the job is dropped without being run if the token is
+        /// cancelled before a worker takes it (jobs that must run anyway, e.g. to release their dependents, are expected to check it).
+        size_t enqueue_job(JobT job, std::shared_ptr<JobToken> token, bool drop_if_cancelled = true);
+
+        /// Reorders the prioritized jobs according to the current priority of their tokens, and drops the cancelled ones.
+        void update_priorities();
+
+        /// Waits until every enqueued job has been taken by a worker.
         void drain();
 
     private:
+        /// Returns the id of the calling thread within the pool, or -1 if it isn't a worker of the pool.
+        int get_current_thread_id() const;
+
+        /// Takes a job from the worker's own deque, then from the injection queue, then from the priority queue, then from the deque of
+        /// another worker.
+        JobT *take_job(size_t thread_id);
+        JobT *take_prioritized_job();
+        JobT *steal_job(size_t thread_id);
+
+        /// The jobs are allocated from the BlockPool as the deques hold pointers.
+        static JobT *create_job(JobT &&job);
+        static void destroy_job(JobT *job);
+
+        void push_injected_job(JobT *job);
+        JobT *pop_injected_job();
+
+        void notify_job_enqueued();
+        void notify_job_taken();
+
+        /// Puts the worker to sleep until a job is enqueued, unless a job has been enqueued meanwhile.
+        void wait_for_job(size_t thread_id);
+
         void thread_loop(size_t thread_id);
     };
 }  // namespace explo
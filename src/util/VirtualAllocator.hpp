@@ -1,10 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
-#include "vk_mem_alloc.h"
-
 namespace explo
 {
     /// An allocator that allows resizing of the managed memory.
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace explo
+{
+    /// A lock-free single-owner deque (Chase-Lev): the owner thread pushes and pops at the bottom (LIFO), any other thread steals
+    /// from the top (FIFO). The storage grows as needed; the replaced buffers are kept until destruction as thieves could still be
+    /// reading them.
+    ///
+    /// The items must be trivially copyable (e.g. pointers), a default constructed item is returned when the deque is empty or the
+    /// steal lost a race.
+    template <typename _T>
+    class WorkStealingDeque
+    {
+        static_assert(std::is_trivially_copyable_v<_T>);
+
+    private:
+        class Buffer
+        {
+        private:
+            int64_t m_capacity;
+            std::unique_ptr<std::atomic<_T>[]> m_items;
+
+        public:
+            explicit Buffer(int64_t capacity) :
+                m_capacity(capacity),
+                m_items(std::make_unique<std::atomic<_T>[]>(capacity))
+            {
+            }
+
+            int64_t get_capacity() const { return m_capacity; }
+
+            _T get(int64_t i) const { return m_items[i & (m_capacity - 1)].load(std::memory_order_relaxed); }
+            void put(int64_t i, _T item) { m_items[i & (m_capacity - 1)].store(item, std::memory_order_relaxed); }
+
+            /// Creates a buffer twice as large holding the items within [top, bottom).
+            std::unique_ptr<Buffer> grow(int64_t top, int64_t bottom) const
+            {
+                auto buffer = std::make_unique<Buffer>(m_capacity * 2);
+                for (int64_t i = top; i < bottom; i++) buffer->put(i, get(i));
+                return buffer;
+            }
+        };
+
+        // The indices are written by different threads: keep them on different cache lines
+        alignas(64) std::atomic<int64_t> m_top = 0;
+        alignas(64) std::atomic<int64_t> m_bottom = 0;
+        alignas(64) std::atomic<Buffer *> m_buffer;
+
+        std::vector<std::unique_ptr<Buffer>> m_buffers;  ///< Owned by the owner thread, the last one is the current
+
+    public:
+        explicit WorkStealingDeque(int64_t capacity = 256)
+        {
+            m_buffers.push_back(std::make_unique<Buffer>(capacity));  // Must be a power of two
+            m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+        }
+
+        ~WorkStealingDeque() = default;
+
+        WorkStealingDeque(WorkStealingDeque const &) = delete;
+        WorkStealingDeque &operator=(WorkStealingDeque const &) = delete;
+
+        /// Returns an approximation of the number of items, as other threads could be pushing or stealing meanwhile.
+        size_t size() const
+        {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+            return bottom > top ? size_t(bottom - top) : 0;
+        }
+
+        bool empty() const { return size() == 0; }
+
+        /// Pushes the item at the bottom. Must only be called by the owner thread.
+        void push(_T item)
+        {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t top = m_top.load(std::memory_order_acquire);
+            Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+
+            if (bottom - top > buffer->get_capacity() - 1)
+            {
+                m_buffers.push_back(buffer->grow(top, bottom));
+                buffer = m_buffers.back().get();
+                m_buffer.store(buffer, std::memory_order_release);
+            }
+
+            buffer->put(bottom, item);
+
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        /// Pops the last pushed item. Must only be called by the owner thread.
+        _T pop()
+        {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+            m_bottom.store(bottom, std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            int64_t top = m_top.load(std::memory_order_relaxed);
+            if (top > bottom)  // Empty
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return _T{};
+            }
+
+            _T item = buffer->get(bottom);
+            if (top == bottom)
+            {
+                // Last item: race against the thieves for it
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) item = _T{};
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        /// Steals the first pushed item. Can be called by any thread.
+        _T steal()
+        {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom) return _T{};  // Empty
+
+            Buffer *buffer = m_buffer.load(std::memory_order_acquire);
+            _T item = buffer->get(top);
+
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return _T{};  // Lost against the owner or another thief
+
+            return item;
+        }
+    };
+}  // namespace explo
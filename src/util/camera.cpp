@@ -1,5 +1,7 @@
 #include "camera.hpp"
 
+#include <glm/gtc/matrix_transform.hpp>
+
 glm::mat4 explo::build_orientation_mat(float yaw, float pitch)
 {
     glm::mat4 m(1);
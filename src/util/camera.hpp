@@ -1,12 +1,9 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include <vren/camera.hpp>
 
 namespace explo
 {
-    using camera_t = vren::camera;
-
     glm::mat4 build_orientation_mat(float yaw, float pitch);
 
     inline glm::vec3 get_right_vec(glm::mat4 const &orientation_mat)
@@ -29,3 +29,10 @@ uint64_t explo::get_nanos_since_epoch()
 
     return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
 }
+
+uint64_t explo::get_steady_nanos()
+{
+    using namespace std::chrono;
+
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
@@ -1,20 +1,35 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
+#include <functional>
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #include <string>
 
 namespace explo
 {
+    /// Hashes glm vectors (e.g. chunk positions). Every component is folded in with a multiply-xorshift step and the result is finalized
+    /// with the splitmix64 mixer: permuted or repeated components (e.g. (1, 0, 2) and (2, 0, 1)) don't collide, and every bit of the
+    /// result depends on every component, as std::unordered_map keeps the low bits only.
     struct vec_hash
     {
         template <glm::length_t _length, typename _t>
         size_t operator()(glm::vec<_length, _t> const &vec) const
         {
-            size_t result = 0;
-            for (glm::length_t i = 0; i < _length; i++) result ^= vec[i];
-            return result;
+            uint64_t result = 0;
+            for (glm::length_t i = 0; i < _length; i++)
+            {
+                result = (result + uint64_t(std::hash<_t>{}(vec[i]))) * 0x9E3779B97F4A7C15ull;
+                result ^= result >> 32;
+            }
+
+            result ^= result >> 30;
+            result *= 0xBF58476D1CE4E5B9ull;
+            result ^= result >> 27;
+            result *= 0x94D049BB133111EBull;
+            result ^= result >> 31;
+            return size_t(result);
         }
     };
 
@@ -38,6 +53,9 @@ namespace explo
 
     uint64_t get_nanos_since_epoch();
 
+    /// Reads a monotonic clock, in nanoseconds from an unspecified origin: to be used to measure elapsed times.
+    uint64_t get_steady_nanos();
+
     template <typename _IntT>
     _IntT ceil_to_power_of_2(_IntT n)
     {
@@ -1,12 +1,48 @@
 #include "profile_stats.hpp"
 
 #include <algorithm>
+#include <cmath>
 
-void explo::profile_stats::push_elapsed_time(uint64_t elapsed_time)
+using namespace explo;
+
+// ------------------------------------------------------------------------------------------------
+// profile_stats
+// ------------------------------------------------------------------------------------------------
+
+profile_stats::profile_stats(size_t window_size) :
+    m_window_size(window_size)
+{
+    if (m_window_size > 0) m_window.reserve(m_window_size);
+    else m_histogram = std::make_unique<LatencyHistogram>();
+}
+
+uint64_t profile_stats::quantile_ns(double quantile) const
+{
+    if (m_window_size == 0) return m_histogram->get_quantile(quantile);
+
+    if (m_window.empty()) return 0;
+
+    // The window is small (e.g. a few hundreds of frames) and the quantiles are read at most once per frame: select on a copy
+    std::vector<uint64_t> samples = m_window;
+
+    size_t rank = std::max(size_t(std::ceil(std::clamp(quantile, 0.0, 1.0) * double(samples.size()))), size_t(1));
+    std::nth_element(samples.begin(), samples.begin() + (rank - 1), samples.end());
+    return samples[rank - 1];
+}
+
+void profile_stats::push_elapsed_time(uint64_t elapsed_time)
 {
+    m_last_elapsed_ns = elapsed_time;
+
+    if (m_window_size > 0)
+    {
+        push_windowed(elapsed_time);
+        m_sample_count++;
+        return;
+    }
+
     m_min_elapsed_ns = std::min(elapsed_time, m_min_elapsed_ns);
     m_max_elapsed_ns = std::max(elapsed_time, m_max_elapsed_ns);
-    m_last_elapsed_ns = elapsed_time;
 
     if (m_sample_count == 0)
     {
@@ -18,12 +54,114 @@ void explo::profile_stats::push_elapsed_time(uint64_t elapsed_time)
         m_avg_elapsed_ns += double(elapsed_time - m_avg_elapsed_ns) / double(m_sample_count + 1);
     }
 
+    m_histogram->record(elapsed_time);
+
     m_sample_count++;
 }
 
-void explo::monitor<explo::profile_stats>::push_elapsed_time(uint64_t elapsed_time)
+void profile_stats::push_windowed(uint64_t elapsed_time)
+{
+    uint64_t evicted = 0;
+    bool full = m_window.size() == m_window_size;
+
+    if (full)
+    {
+        evicted = m_window[m_window_next];
+        m_window[m_window_next] = elapsed_time;
+        m_window_sum -= evicted;
+    }
+    else
+    {
+        m_window.push_back(elapsed_time);
+    }
+
+    m_window_next = (m_window_next + 1) % m_window_size;
+    m_window_sum += elapsed_time;
+
+    m_avg_elapsed_ns = double(m_window_sum) / double(m_window.size());
+
+    // The min/max only need to be searched again when the evicted sample was one of them
+    if (full && (evicted == m_min_elapsed_ns || evicted == m_max_elapsed_ns))
+    {
+        auto [min, max] = std::minmax_element(m_window.begin(), m_window.end());
+        m_min_elapsed_ns = *min;
+        m_max_elapsed_ns = *max;
+    }
+    else
+    {
+        m_min_elapsed_ns = std::min(elapsed_time, m_min_elapsed_ns);
+        m_max_elapsed_ns = std::max(elapsed_time, m_max_elapsed_ns);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// concurrent_profile_stats
+// ------------------------------------------------------------------------------------------------
+
+uint64_t concurrent_profile_stats::min_ns() const
+{
+    uint64_t min = UINT64_MAX;
+    for (slot const &slot : m_slots) min = std::min(slot.m_min_elapsed_ns.load(std::memory_order_relaxed), min);
+    return min;
+}
+
+uint64_t concurrent_profile_stats::max_ns() const
+{
+    uint64_t max = 0;
+    for (slot const &slot : m_slots) max = std::max(slot.m_histogram.get_max(), max);
+    return max;
+}
+
+double concurrent_profile_stats::avg_ns() const
+{
+    double sum = 0.0;
+    uint64_t count = 0;
+    for (slot const &slot : m_slots)
+    {
+        uint64_t slot_count = slot.m_histogram.get_count();
+        sum += slot.m_histogram.get_mean() * double(slot_count);
+        count += slot_count;
+    }
+    return count > 0 ? sum / double(count) : 0.0;
+}
+
+uint64_t concurrent_profile_stats::quantile_ns(double quantile) const
+{
+    LatencyHistogram histogram{};
+    for (slot const &slot : m_slots) histogram.merge(slot.m_histogram);
+    return histogram.get_quantile(quantile);
+}
+
+size_t concurrent_profile_stats::sample_count() const
+{
+    size_t count = 0;
+    for (slot const &slot : m_slots) count += slot.m_histogram.get_count();
+    return count;
+}
+
+void concurrent_profile_stats::push_elapsed_time(uint64_t elapsed_time)
+{
+    slot &slot = get_thread_slot();
+
+    slot.m_histogram.record(elapsed_time);
+
+    uint64_t min = slot.m_min_elapsed_ns.load(std::memory_order_relaxed);
+    while (elapsed_time < min && !slot.m_min_elapsed_ns.compare_exchange_weak(min, elapsed_time, std::memory_order_relaxed)) {}
+}
+
+void concurrent_profile_stats::reset()
+{
+    for (slot &slot : m_slots)
+    {
+        slot.m_min_elapsed_ns.store(UINT64_MAX, std::memory_order_relaxed);
+        slot.m_histogram.reset();
+    }
+}
+
+concurrent_profile_stats::slot &concurrent_profile_stats::get_thread_slot()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    static std::atomic<size_t> next_slot_index = 0;
+    thread_local size_t slot_index = next_slot_index.fetch_add(1, std::memory_order_relaxed) % k_slot_count;
 
-    m_handle.push_elapsed_time(elapsed_time);
+    return m_slots[slot_index];
 }
@@ -1,65 +1,45 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdint>
-#include <functional>
-#include <mutex>
-#include <type_traits>
+#include <memory>
+#include <vector>
+
+#include "LatencyHistogram.hpp"
 
 namespace explo
 {
-    // ------------------------------------------------------------------------------------------------
-    // monitor
-    // ------------------------------------------------------------------------------------------------
-
-    template <typename _t>
-    class base_monitor
-    {
-    protected:
-        _t m_handle;
-        mutable std::mutex m_mutex;
-
-    public:
-        _t read() const
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            return m_handle;
-        }
-    };
-
-    template <typename _t>
-    class monitor : public base_monitor<_t>
-    {
-    };
-
-    template <typename _t>
-    void access(_t const &object, std::function<void(_t const &)> const &callback)
-    {
-        callback(object);
-    }
-
-    template <typename _t>  // template specialization for monitor<_t>
-    void access(monitor<_t> const &monitored_object, std::function<void(_t const &)> const &callback)
-    {
-        _t t = monitored_object.read();
-        callback(t);
-    }
-
     // ------------------------------------------------------------------------------------------------
     // profile_stats
     // ------------------------------------------------------------------------------------------------
 
+    /// Min/max/average and quantiles of a series of samples. The samples are usually elapsed times in nanoseconds, but can be any unsigned
+    /// quantity (e.g. a queue depth), read through the unitless getters.
+    ///
+    /// With a window, the stats only cover the last window_size samples (e.g. the last seconds of frames), so that a spike isn't averaged
+    /// away by the whole history; the quantiles are exact. Without, they cover every sample and the quantiles are estimated by a
+    /// LatencyHistogram. Not thread safe, see concurrent_profile_stats.
     class profile_stats
     {
         uint64_t m_min_elapsed_ns = UINT64_MAX;
         uint64_t m_max_elapsed_ns = 0;
         uint64_t m_last_elapsed_ns = UINT64_MAX;
 
-        double m_avg_elapsed_ns;
+        double m_avg_elapsed_ns = 0.0;
 
         size_t m_sample_count = 0;  ///< The total number of samples pushed
 
+        size_t m_window_size;
+        std::vector<uint64_t> m_window;  ///< The last samples, circular once full (empty if there's no window)
+        size_t m_window_next = 0;
+        uint64_t m_window_sum = 0;
+
+        std::unique_ptr<LatencyHistogram> m_histogram;  ///< Only without a window (it takes a few KB)
+
     public:
-        explicit profile_stats() = default;
+        /// \param window_size The number of (latest) samples the stats cover, 0 meaning all of them.
+        explicit profile_stats(size_t window_size = 0);
         ~profile_stats() = default;
 
         uint64_t min_ns() const { return m_min_elapsed_ns; }
@@ -72,18 +52,75 @@ namespace explo
         double avg_ms() const { return m_avg_elapsed_ns / 1'000'000.0; }
         double last_ms() const { return m_last_elapsed_ns / 1'000'000.0; }
 
+        uint64_t min_value() const { return m_min_elapsed_ns; }
+        uint64_t max_value() const { return m_max_elapsed_ns; }
+        uint64_t last_value() const { return m_last_elapsed_ns; }
+        double avg_value() const { return m_avg_elapsed_ns; }
+
+        /// Returns the sample below which the given fraction (between 0 and 1) of the samples lie, 0 if there's no sample.
+        uint64_t quantile_ns(double quantile) const;
+        double quantile_ms(double quantile) const { return quantile_ns(quantile) / 1'000'000.0; }
+        uint64_t quantile_value(double quantile) const { return quantile_ns(quantile); }
+
+        size_t sample_count() const { return m_sample_count; }
+        size_t window_size() const { return m_window_size; }
+
         void push_elapsed_time(uint64_t elapsed_time);
+        void push_sample(uint64_t value) { push_elapsed_time(value); }
+
+    private:
+        void push_windowed(uint64_t elapsed_time);
     };
 
     // ------------------------------------------------------------------------------------------------
-    // monitor<profile_stats>
+    // concurrent_profile_stats
     // ------------------------------------------------------------------------------------------------
 
-    template <>
-    class monitor<profile_stats> : public base_monitor<profile_stats>
+    /// The profile_stats of samples pushed from several threads (e.g. the chunk generation times measured by the workers). Every thread
+    /// accumulates into its own slot with relaxed atomics, without locking (beyond k_slot_count threads, the slots are shared); the slots
+    /// are merged on read. The stats cover every sample until reset().
+    class concurrent_profile_stats
     {
     public:
+        static constexpr size_t k_slot_count = 8;
+
+    private:
+        struct alignas(64) slot
+        {
+            std::atomic<uint64_t> m_min_elapsed_ns = UINT64_MAX;
+            LatencyHistogram m_histogram;  ///< Holds the sample count, sum and max
+        };
+
+        std::array<slot, k_slot_count> m_slots;
+
+    public:
+        explicit concurrent_profile_stats() = default;
+        ~concurrent_profile_stats() = default;
+
+        uint64_t min_ns() const;
+        uint64_t max_ns() const;
+        double avg_ns() const;
+
+        double min_ms() const { return min_ns() / 1'000'000.0; }
+        double max_ms() const { return max_ns() / 1'000'000.0; }
+        double avg_ms() const { return avg_ns() / 1'000'000.0; }
+
+        /// Estimated by the merged histogram of the slots.
+        uint64_t quantile_ns(double quantile) const;
+        double quantile_ms(double quantile) const { return quantile_ns(quantile) / 1'000'000.0; }
+
+        size_t sample_count() const;
+
+        /// Can be called from any thread.
         void push_elapsed_time(uint64_t elapsed_time);
+        void push_sample(uint64_t value) { push_elapsed_time(value); }
+
+        /// Clears the samples. Not atomic: samples pushed meanwhile could be partially kept.
+        void reset();
+
+    private:
+        /// Returns the slot of the calling thread.
+        slot &get_thread_slot();
     };
 
 }  // namespace explo
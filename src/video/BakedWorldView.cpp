@@ -1,6 +1,7 @@
 #include "BakedWorldView.hpp"
 
 #include "Renderer.hpp"
+#include "util/Profiler.hpp"
 
 using namespace explo;
 
@@ -114,7 +115,7 @@ glm::ivec3 BakedWorldView::to_relative_chunk_position(glm::ivec3 const &chunk_po
     return chunk_pos - m_position + m_render_distance;
 }
 
-size_t BakedWorldView::place_data(DeviceBuffer &buffer, VirtualAllocator &allocator, void *data, size_t data_size)
+size_t BakedWorldView::place_data(DeviceBuffer &buffer, VirtualAllocator &allocator, void const *data, size_t data_size)
 {
     size_t alloc_offset;
     while (true)
@@ -145,18 +146,23 @@ void BakedWorldView::set_position(glm::ivec3 const &new_position)
 
 void BakedWorldView::upload_chunk(Chunk const &chunk)
 {
+    PROFILE_SCOPE("BakedWorldView::upload_chunk");
+
     // The user asked to upload a chunk that is outside the world view. This can happen frequently because the chunk
     // construction is asynchronous and if the player is travelling through the world fast, chunks could be built when they're
     // no longer inside the world view
     glm::ivec3 chunk_pos = chunk.get_position();
     if (!is_chunk_position_inside(chunk_pos)) return;
 
-    std::unique_ptr<Surface> const &surface = chunk.m_surface;
+    std::shared_ptr<Surface const> surface = chunk.get_surface();
 
     // The chunk doesn't have the surface! Instead of throwing, we silently
     // ignore the uploading
     if (!surface || surface->m_vertices.empty() || surface->m_indices.empty() || surface->m_instances.empty()) return;
 
+    // The chunk was already uploaded and its surface got regenerated (e.g. a neighbour was generated): replace the old geometry
+    destroy_chunk(chunk_pos);
+
     size_t vertex_offset =
         place_data(m_vertex_buffer, m_vertex_buffer_allocator, surface->m_vertices.data(), surface->m_vertices.size() * sizeof(SurfaceVertex));
 
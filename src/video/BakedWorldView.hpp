@@ -111,7 +111,7 @@ namespace explo
     private:
         /// Places the given data in the device buffer eventually re-allocating it if doesn't fit.
         /// \return The offset, within the buffer, where the data is allocated.
-        size_t place_data(DeviceBuffer &buffer, VirtualAllocator &allocator, void *data, size_t data_size);
+        size_t place_data(DeviceBuffer &buffer, VirtualAllocator &allocator, void const *data, size_t data_size);
 
         glm::ivec3 to_relative_chunk_position(glm::ivec3 const &chunk_pos) const;
     };
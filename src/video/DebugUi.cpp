@@ -1,9 +1,11 @@
 #include "DebugUi.hpp"
 
+#include <fstream>
 #include <imgui.h>
 
 #include "Game.hpp"
 #include "Renderer.hpp"
+#include "util/Profiler.hpp"
 #include "util/system.hpp"
 
 using namespace explo;
@@ -123,6 +125,75 @@ void DebugUi::display_world_view_window()
     ImGui::End();
 }
 
+void DebugUi::display_chunk_metrics_window()
+{
+    Entity &player = *explo::game().m_player;
+    ChunkMetrics &chunk_metrics = player.get_world().get_chunk_metrics();
+
+    auto display_histogram = [](char const *name, LatencyHistogram const &histogram)
+    {
+        ImGui::Text(
+            "%-18s Count: %6zu, p50: %8.3f ms, p95: %8.3f ms, p99: %8.3f ms, Max: %8.3f ms",
+            name,
+            size_t(histogram.get_count()),
+            histogram.get_quantile_ms(0.50),
+            histogram.get_quantile_ms(0.95),
+            histogram.get_quantile_ms(0.99),
+            histogram.get_max_ms()
+        );
+    };
+
+    auto display_generation_time = [](char const *name, concurrent_profile_stats const &stats)
+    {
+        ImGui::Text(
+            "%-18s Count: %6zu, p50: %8.3f ms, p95: %8.3f ms, p99: %8.3f ms, Max: %8.3f ms",
+            name,
+            stats.sample_count(),
+            stats.quantile_ms(0.50),
+            stats.quantile_ms(0.95),
+            stats.quantile_ms(0.99),
+            stats.max_ms()
+        );
+    };
+
+    if (ImGui::Begin("Chunk pipeline"))
+    {
+        ImGui::Text("Latency since the chunk was loaded:");
+        for (uint32_t stage = 0; stage < ChunkStage_Count; stage++)
+            display_histogram(ChunkMetrics::get_stage_name(ChunkStage(stage)), chunk_metrics.get_stage_latency(ChunkStage(stage)));
+
+        ImGui::Separator();
+
+        ImGui::Text("Generation time:");
+        display_generation_time("volume", chunk_metrics.get_volume_generation_time());
+        display_generation_time("surface", chunk_metrics.get_surface_generation_time());
+
+        ImGui::Separator();
+
+        ChunkMetrics::Counters counters = chunk_metrics.get_counters();
+        ImGui::Text("Cancelled: %zu, Stale: %zu", size_t(counters.m_cancelled_count), size_t(counters.m_stale_count));
+        ImGui::Text(
+            "Surface regenerations: %zu, Reuploads: %zu",
+            size_t(counters.m_surface_regeneration_count),
+            size_t(counters.m_reupload_count)
+        );
+
+        ImGui::Separator();
+
+        if (ImGui::Button("Dump to chunk_metrics.json"))
+        {
+            std::ofstream stream("chunk_metrics.json");
+            chunk_metrics.write_json(stream);
+        }
+
+        ImGui::SameLine();
+
+        if (ImGui::Button("Reset")) chunk_metrics.reset();
+    }
+
+    ImGui::End();
+}
+
 void DebugUi::display_baked_world_view_window()
 {
     if (!m_renderer.has_world_view()) return;
@@ -167,6 +238,25 @@ void DebugUi::display_renderer_window()
     {
         ImGui::Text("Dt: %.3f", game().m_dt);
         ImGui::Text("FPS: %d", game().m_fps);
+
+        profile_stats const &frame_stats = m_renderer.get_profile_stats();
+        ImGui::Text(
+            "Frame time (last %zu); Avg: %.3f ms, p50: %.3f ms, p99: %.3f ms, Max: %.3f ms",
+            frame_stats.window_size(),
+            frame_stats.avg_ms(),
+            frame_stats.quantile_ms(0.50),
+            frame_stats.quantile_ms(0.99),
+            frame_stats.max_ms()
+        );
+
+        ImGui::Separator();
+
+        // The latest zones of every thread, e.g. to take right after a stutter
+        if (ImGui::Button("Dump trace to explo_trace.json"))
+        {
+            std::ofstream stream("explo_trace.json");
+            profiler().write_chrome_trace(stream);
+        }
     }
 
     ImGui::End();
@@ -179,7 +269,20 @@ void DebugUi::display_jobs_window()
     // Thread pool
     if (ImGui::Begin("Thread pool"))
     {
-        ImGui::Text("Main thread jobs: -1");  // todo
+        SyncJobExecutor &main_thread_executor = game().m_main_thread_executor;
+        profile_stats const &process_stats = main_thread_executor.get_process_stats();
+        profile_stats const &queue_depth_stats = main_thread_executor.get_queue_depth_stats();
+
+        ImGui::Text("Main thread jobs: %zu", main_thread_executor.get_job_count());
+        ImGui::Text(
+            "Main thread queue depth; Last: %zu, Avg: %.1f, Max: %zu",
+            size_t(queue_depth_stats.last_value()),
+            queue_depth_stats.avg_value(),
+            size_t(queue_depth_stats.max_value())
+        );
+        ImGui::Text(
+            "Main thread time; Last: %.3f ms, Avg: %.3f ms, Max: %.3f ms", process_stats.last_ms(), process_stats.avg_ms(), process_stats.max_ms()
+        );
 
         ImGui::Separator();
 
@@ -241,6 +344,7 @@ void DebugUi::display()
 {
     display_jobs_window();
     display_player_window();
+    display_chunk_metrics_window();
     display_renderer_window();
     display_baked_world_view_window();
     display_vma_memory_statistics();
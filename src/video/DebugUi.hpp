@@ -20,6 +20,7 @@ namespace explo
         void display_jobs_window();
         void display_player_window();
         void display_world_view_window();
+        void display_chunk_metrics_window();
         void display_baked_world_view_window();
         void display_renderer_window();
         void display_vma_memory_statistics();
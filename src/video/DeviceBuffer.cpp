@@ -15,7 +15,7 @@ DeviceBuffer::DeviceBuffer(Renderer &renderer, VkMemoryPropertyFlags memory_prop
 
 DeviceBuffer::~DeviceBuffer() {}
 
-void DeviceBuffer::write(void *data, size_t data_size, size_t offset)
+void DeviceBuffer::write(void const *data, size_t data_size, size_t offset)
 {
     // TODO IMPROVEMENT: Cache and re-use the staging buffers; avoid allocating each write
 
@@ -42,7 +42,7 @@ namespace explo
         size_t get_size() const { return m_size; }
         size_t get_pending_operations_count() const { return m_operations.size(); }
 
-        void write(void *data, size_t data_size, size_t offset);
+        void write(void const *data, size_t data_size, size_t offset);
         void resize(size_t init_size);
 
         void record(VkCommandBuffer command_buffer, vren::resource_container &resource_container);
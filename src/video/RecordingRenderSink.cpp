@@ -0,0 +1,84 @@
+#include "RecordingRenderSink.hpp"
+
+#include "world/Chunk.hpp"
+#include "world/World.hpp"
+
+using namespace explo;
+
+void RecordingRenderSink::world_view_recreate(glm::ivec3 const &init_chunk_pos, glm::ivec3 const &render_distance)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_position = init_chunk_pos;
+    m_render_distance = render_distance;
+    m_resident_chunks.clear();
+}
+
+void RecordingRenderSink::world_view_set_position(glm::ivec3 const &chunk_pos)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_position = chunk_pos;
+    std::erase_if(
+        m_resident_chunks,
+        [this](glm::ivec3 const &resident_chunk_pos)
+        {
+            return !is_inside_world_view(resident_chunk_pos);
+        }
+    );
+}
+
+void RecordingRenderSink::world_view_upload_chunk(std::shared_ptr<Chunk> const &chunk)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_counters.m_upload_count++;
+
+    if (!is_inside_world_view(chunk->get_position()))
+    {
+        m_counters.m_ignored_upload_count++;
+        return;
+    }
+
+    m_resident_chunks.emplace(chunk->get_position());
+
+    chunk->get_world().get_chunk_metrics().record_upload(*chunk);
+}
+
+void RecordingRenderSink::world_view_destroy_chunk(glm::ivec3 const &chunk_pos)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_counters.m_destroy_count++;
+    m_resident_chunks.erase(chunk_pos);
+}
+
+void RecordingRenderSink::block_registry_upload(BlockRegistry const &block_registry)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_counters.m_block_registry_upload_count++;
+}
+
+size_t RecordingRenderSink::get_resident_chunk_count() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_resident_chunks.size();
+}
+
+bool RecordingRenderSink::is_chunk_resident(glm::ivec3 const &chunk_pos) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_resident_chunks.contains(chunk_pos);
+}
+
+RecordingRenderSink::Counters RecordingRenderSink::get_counters() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_counters;
+}
+
+bool RecordingRenderSink::is_inside_world_view(glm::ivec3 const &chunk_pos) const
+{
+    glm::ivec3 offset = glm::abs(chunk_pos - m_position);
+    return offset.x <= m_render_distance.x && offset.y <= m_render_distance.y && offset.z <= m_render_distance.z;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_set>
+
+#include "RenderSink.hpp"
+#include "util/misc.hpp"
+
+namespace explo
+{
+    /// A RenderSink keeping track of what a renderer would hold: the chunks uploaded within the current world view, and the number of
+    /// actions. Used to stream the world headless (e.g. to measure the generation throughput) and in tests.
+    class RecordingRenderSink : public RenderSink
+    {
+    public:
+        struct Counters
+        {
+            size_t m_upload_count = 0;          ///< Including the surface regenerations
+            size_t m_ignored_upload_count = 0;  ///< The uploads of chunks outside the world view (as the renderer would)
+            size_t m_destroy_count = 0;
+            size_t m_block_registry_upload_count = 0;
+        };
+
+    private:
+        mutable std::mutex m_mutex;  ///< The chunks are uploaded by the workers
+
+        glm::ivec3 m_position = glm::ivec3(0);
+        glm::ivec3 m_render_distance = glm::ivec3(-1);  ///< Negative until the world view is created
+        std::unordered_set<glm::ivec3, vec_hash> m_resident_chunks;
+        Counters m_counters;
+
+    public:
+        explicit RecordingRenderSink() = default;
+        ~RecordingRenderSink() override = default;
+
+        void world_view_recreate(glm::ivec3 const &init_chunk_pos, glm::ivec3 const &render_distance) override;
+        void world_view_set_position(glm::ivec3 const &chunk_pos) override;
+        void world_view_upload_chunk(std::shared_ptr<Chunk> const &chunk) override;
+        void world_view_destroy_chunk(glm::ivec3 const &chunk_pos) override;
+
+        void block_registry_upload(BlockRegistry const &block_registry) override;
+
+        /// Returns the number of chunks of the world view uploaded at least once.
+        size_t get_resident_chunk_count() const;
+        bool is_chunk_resident(glm::ivec3 const &chunk_pos) const;
+
+        Counters get_counters() const;
+
+    private:
+        bool is_inside_world_view(glm::ivec3 const &chunk_pos) const;
+    };
+}  // namespace explo
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <memory>
+
+namespace explo
+{
+    // Forward decl
+    class BlockRegistry;
+    class Chunk;
+
+    /// The rendering actions requested by the world (WorldView, BlockRegistry). Decouples the world streaming from the renderer, so that
+    /// it can run without a window or a GPU (see NullRenderSink, RecordingRenderSink).
+    class RenderSink
+    {
+    public:
+        explicit RenderSink() = default;
+        virtual ~RenderSink() = default;
+
+        /* World view */
+
+        virtual void world_view_recreate(glm::ivec3 const &init_chunk_pos, glm::ivec3 const &render_distance) = 0;
+        virtual void world_view_set_position(glm::ivec3 const &chunk_pos) = 0;
+
+        /// Called from a worker thread, every time the surface of the chunk is (re)generated. The chunk could have left the world view
+        /// meanwhile.
+        virtual void world_view_upload_chunk(std::shared_ptr<Chunk> const &chunk) = 0;
+
+        virtual void world_view_destroy_chunk(glm::ivec3 const &chunk_pos) = 0;
+
+        /* Block registry */
+
+        virtual void block_registry_upload(BlockRegistry const &block_registry) = 0;
+    };
+
+    /// A RenderSink ignoring every action.
+    class NullRenderSink : public RenderSink
+    {
+    public:
+        void world_view_recreate(glm::ivec3 const &init_chunk_pos, glm::ivec3 const &render_distance) override {}
+        void world_view_set_position(glm::ivec3 const &chunk_pos) override {}
+        void world_view_upload_chunk(std::shared_ptr<Chunk> const &chunk) override {}
+        void world_view_destroy_chunk(glm::ivec3 const &chunk_pos) override {}
+        void block_registry_upload(BlockRegistry const &block_registry) override {}
+    };
+}  // namespace explo
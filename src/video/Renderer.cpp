@@ -7,6 +7,7 @@
 
 #include "Game.hpp"
 #include "log.hpp"
+#include "util/Profiler.hpp"
 
 using namespace explo;
 
@@ -149,6 +150,8 @@ void Renderer::on_frame(
     vren::resource_container &res_container
 )
 {
+    PROFILE_SCOPE("Renderer::on_frame");
+
     if (!m_baked_world_view) return;
 
     // Barrier to ensure this frame's commands are executed only when ALL the previous commands have executed on GPU
@@ -312,6 +315,8 @@ void Renderer::upload_block_registry(BlockRegistry const &block_registry)
 
     texture_manager.m_textures.clear();
 
+    m_block_type_count = block_registry.size();
+
     if (block_registry.size() > 0)
     {
         std::vector<uint32_t> image_data{};
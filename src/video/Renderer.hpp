@@ -3,9 +3,11 @@
 #include <GLFW/glfw3.h>
 #include <volk.h>
 
+#include <functional>
 #include <glm/glm.hpp>
 #include <memory>
 #include <vector>
+#include <vren/camera.hpp>
 #include <vren/context.hpp>
 #include <vren/pipeline/clustered_shading.hpp>
 #include <vren/pipeline/debug_renderer.hpp>
@@ -33,12 +35,15 @@ namespace explo
         friend class DeviceImage3d;
         friend class DrawChunkList;
 
+    public:
+        static constexpr size_t k_frame_stats_window_size = 240;  ///< The frame time stats cover the last seconds
+
     private:
         GLFWwindow *m_window;
 
         vren::context m_context;
 
-        profile_stats m_profile_stats;
+        profile_stats m_profile_stats{k_frame_stats_window_size};  ///< The frame recording time
 
         vren::vk_surface_khr m_surface;
         vren::presenter m_presenter;
@@ -57,6 +62,7 @@ namespace explo
 
         vren::light_array m_light_array;
         vren::material_buffer m_material_buffer;
+        uint32_t m_block_type_count = 0;  ///< Needed to address the block atlas from the block type of the chunk vertices
 
         std::function<void()> m_ui_setup_function;
 
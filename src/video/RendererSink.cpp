@@ -0,0 +1,49 @@
+#include "RendererSink.hpp"
+
+#include "video/RenderApi.hpp"
+#include "world/World.hpp"
+
+using namespace explo;
+
+RendererSink::RendererSink(SyncJobExecutor &main_thread_executor) :
+    m_main_thread_executor(main_thread_executor)
+{
+}
+
+void RendererSink::world_view_recreate(glm::ivec3 const &init_chunk_pos, glm::ivec3 const &render_distance)
+{
+    RenderApi::world_view_recreate(init_chunk_pos, render_distance);
+}
+
+void RendererSink::world_view_set_position(glm::ivec3 const &chunk_pos)
+{
+    RenderApi::world_view_set_position(chunk_pos);
+}
+
+void RendererSink::world_view_upload_chunk(std::shared_ptr<Chunk> const &chunk)
+{
+    m_main_thread_executor.enqueue_job(
+        [weak_chunk = std::weak_ptr(chunk)]()
+        {
+            std::shared_ptr<Chunk> chunk = weak_chunk.lock();
+            if (!chunk) return;
+
+            // Try to upload the chunk for rendering. Since the generation is asynchronous, we could be asking the renderer to upload a
+            // chunk that is now outside the world view (e.g. the player moved very fast). In this case the renderer will silently ignore
+            // the uploading
+            RenderApi::world_view_upload_chunk(*chunk);
+
+            chunk->get_world().get_chunk_metrics().record_upload(*chunk);
+        }
+    );
+}
+
+void RendererSink::world_view_destroy_chunk(glm::ivec3 const &chunk_pos)
+{
+    RenderApi::world_view_destroy_chunk(chunk_pos);
+}
+
+void RendererSink::block_registry_upload(BlockRegistry const &block_registry)
+{
+    RenderApi::block_registry_upload(block_registry);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "RenderSink.hpp"
+#include "util/SyncJobExecutor.hpp"
+
+namespace explo
+{
+    /// The RenderSink forwarding to the renderer (RenderApi). The chunks are uploaded from the thread processing the given executor (i.e.
+    /// the main thread), as the renderer isn't thread-safe.
+    class RendererSink : public RenderSink
+    {
+    private:
+        SyncJobExecutor &m_main_thread_executor;
+
+    public:
+        explicit RendererSink(SyncJobExecutor &main_thread_executor);
+        ~RendererSink() override = default;
+
+        void world_view_recreate(glm::ivec3 const &init_chunk_pos, glm::ivec3 const &render_distance) override;
+        void world_view_set_position(glm::ivec3 const &chunk_pos) override;
+        void world_view_upload_chunk(std::shared_ptr<Chunk> const &chunk) override;
+        void world_view_destroy_chunk(glm::ivec3 const &chunk_pos) override;
+
+        void block_registry_upload(BlockRegistry const &block_registry) override;
+    };
+}  // namespace explo
@@ -1,12 +1,16 @@
 #include "DrawChunkList.hpp"
 
+#include <iterator>
+
 #include "video/Renderer.hpp"
+#include "world/surface/Surface.hpp"
 
 using namespace explo;
 
 DrawChunkList::DrawChunkList(Renderer &renderer) :
     m_renderer(renderer),
-    m_basic_renderer(m_renderer.m_context)
+    m_basic_renderer(m_renderer.m_context),
+    m_pipeline(create_pipeline())
 {
 }
 
@@ -29,18 +33,19 @@ void DrawChunkList::record(VkCommandBuffer cmd_buf, vren::resource_container &re
             m_basic_renderer.set_viewport(cmd_buf, fb_size.x, fb_size.y);
             m_basic_renderer.set_scissor(cmd_buf, fb_size.x, fb_size.y);
 
+            m_pipeline.bind(cmd_buf);
+
             m_basic_renderer.set_vertex_buffer(cmd_buf, *vertex_buffer);
             m_basic_renderer.set_index_buffer(cmd_buf, *index_buffer);
             m_basic_renderer.set_instance_buffer(cmd_buf, *instance_buffer);
 
-            m_basic_renderer.set_push_constants(
-                cmd_buf,
-                vren::basic_renderer::push_constants{
-                    .m_camera_view = m_renderer.m_view_matrix,
-                    .m_camera_projection = m_renderer.m_projection_matrix,
-                    .m_material_index = 0,
-                }
-            );
+            PushConstants push_constants{
+                .m_camera_view = m_renderer.m_view_matrix,
+                .m_camera_projection = m_renderer.m_projection_matrix,
+                .m_material_index = 0,
+                .m_block_type_count = m_renderer.m_block_type_count,
+            };
+            m_pipeline.push_constants(cmd_buf, VK_SHADER_STAGE_VERTEX_BIT, &push_constants, sizeof(PushConstants));
 
             vkCmdDrawIndexedIndirectCount(
                 cmd_buf,
@@ -121,3 +126,127 @@ vren::render_graph_t DrawChunkList::create_render_graph_node(vren::render_graph_
     );
     return vren::render_graph_gather(node);
 }
+
+vren::pipeline DrawChunkList::create_pipeline()
+{
+    vren::context const &context = m_renderer.m_context;
+
+    // Vertex input: packed chunk vertices (binding 0) and chunk instances (binding 1)
+    VkVertexInputBindingDescription vertex_bindings[]{
+        {.binding = 0, .stride = sizeof(SurfaceVertex), .inputRate = VK_VERTEX_INPUT_RATE_VERTEX},
+        {.binding = 1, .stride = sizeof(SurfaceInstance), .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE},
+    };
+
+    VkVertexInputAttributeDescription vertex_attributes[]{
+        {.location = 0, .binding = 0, .format = VK_FORMAT_R8G8_UINT, .offset = offsetof(SurfaceVertex, m_x)},     // x, z
+        {.location = 1, .binding = 0, .format = VK_FORMAT_R16_UINT, .offset = offsetof(SurfaceVertex, m_y)},      // y
+        {.location = 2, .binding = 0, .format = VK_FORMAT_R8G8_UINT, .offset = offsetof(SurfaceVertex, m_face)},  // face, block type
+        {.location = 3, .binding = 1, .format = VK_FORMAT_R32G32B32A32_SFLOAT, .offset = sizeof(glm::vec4) * 0},
+        {.location = 4, .binding = 1, .format = VK_FORMAT_R32G32B32A32_SFLOAT, .offset = sizeof(glm::vec4) * 1},
+        {.location = 5, .binding = 1, .format = VK_FORMAT_R32G32B32A32_SFLOAT, .offset = sizeof(glm::vec4) * 2},
+        {.location = 6, .binding = 1, .format = VK_FORMAT_R32G32B32A32_SFLOAT, .offset = sizeof(glm::vec4) * 3},
+    };
+
+    VkPipelineVertexInputStateCreateInfo vertex_input_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = std::size(vertex_bindings),
+        .pVertexBindingDescriptions = vertex_bindings,
+        .vertexAttributeDescriptionCount = std::size(vertex_attributes),
+        .pVertexAttributeDescriptions = vertex_attributes,
+    };
+
+    VkPipelineInputAssemblyStateCreateInfo input_assembly_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        .primitiveRestartEnable = VK_FALSE,
+    };
+
+    VkPipelineViewportStateCreateInfo viewport_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+        .viewportCount = 1,
+        .scissorCount = 1,
+    };
+
+    VkPipelineRasterizationStateCreateInfo rasterization_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+        .depthClampEnable = VK_FALSE,
+        .rasterizerDiscardEnable = VK_FALSE,
+        .polygonMode = VK_POLYGON_MODE_FILL,
+        .cullMode = VK_CULL_MODE_NONE,
+        .frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE,
+        .depthBiasEnable = VK_FALSE,
+        .lineWidth = 1.0f,
+    };
+
+    VkPipelineMultisampleStateCreateInfo multisample_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+        .sampleShadingEnable = VK_FALSE,
+    };
+
+    VkPipelineDepthStencilStateCreateInfo depth_stencil_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+        .depthTestEnable = VK_TRUE,
+        .depthWriteEnable = VK_TRUE,
+        .depthCompareOp = VK_COMPARE_OP_LESS,
+        .depthBoundsTestEnable = VK_FALSE,
+        .stencilTestEnable = VK_FALSE,
+    };
+
+    // The g-buffer attachments: normal, texcoord, material index
+    VkPipelineColorBlendAttachmentState color_blend_attachments[3]{};
+    for (VkPipelineColorBlendAttachmentState &attachment : color_blend_attachments)
+    {
+        attachment.blendEnable = VK_FALSE;
+        attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    }
+
+    VkPipelineColorBlendStateCreateInfo color_blend_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+        .logicOpEnable = VK_FALSE,
+        .attachmentCount = std::size(color_blend_attachments),
+        .pAttachments = color_blend_attachments,
+    };
+
+    VkDynamicState dynamic_states[]{VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamic_state_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+        .dynamicStateCount = std::size(dynamic_states),
+        .pDynamicStates = dynamic_states,
+    };
+
+    VkFormat color_attachment_formats[]{
+        vren::gbuffer::k_normal_buffer_format,
+        vren::gbuffer::k_texcoord_buffer_format,
+        vren::gbuffer::k_material_index_buffer_format,
+    };
+    VkPipelineRenderingCreateInfoKHR pipeline_rendering_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
+        .colorAttachmentCount = std::size(color_attachment_formats),
+        .pColorAttachmentFormats = color_attachment_formats,
+        .depthAttachmentFormat = VREN_DEPTH_BUFFER_OUTPUT_FORMAT,
+    };
+
+    vren::shader_module vertex_shader = vren::load_shader_module_from_file(context, "./resources/shaders/draw_chunk.vert.spv");
+    vren::shader_module fragment_shader = vren::load_shader_module_from_file(context, "./resources/shaders/draw_chunk.frag.spv");
+
+    vren::specialized_shader shaders[]{
+        vren::specialized_shader(vertex_shader),
+        vren::specialized_shader(fragment_shader),
+    };
+
+    return vren::create_graphics_pipeline(
+        context,
+        shaders,
+        &vertex_input_info,
+        &input_assembly_info,
+        nullptr,  // Tessellation
+        &viewport_info,
+        &rasterization_info,
+        &multisample_info,
+        &depth_stencil_info,
+        &color_blend_info,
+        &dynamic_state_info,
+        &pipeline_rendering_info
+    );
+}
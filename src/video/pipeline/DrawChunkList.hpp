@@ -2,22 +2,34 @@
 
 #include <volk.h>
 
+#include <glm/glm.hpp>
 #include <vren/base/resource_container.hpp>
 #include <vren/pipeline/basic_renderer.hpp>
+#include <vren/vk_helpers/shader.hpp>
 
 namespace explo
 {
     // Forward decl
     class Renderer;
 
-    /// A shader program which takes the chunk draw list from the Renderer and renders it to a g-buffer, using vren's basic_renderer module.
+    /// A shader program which takes the chunk draw list from the Renderer and renders it to a g-buffer. The rendering scope is set up by
+    /// vren's basic_renderer module, while the draw uses a pipeline of its own that decodes the packed chunk vertices (SurfaceVertex).
     /// The draw is indirect since the draw calls (i.e. which chunk to render) are filled dynamically by CullWorldView.
     class DrawChunkList
     {
+        struct PushConstants
+        {
+            glm::mat4 m_camera_view;
+            glm::mat4 m_camera_projection;
+            uint32_t m_material_index;
+            uint32_t m_block_type_count;
+        };
+
     private:
         Renderer &m_renderer;
 
         vren::basic_renderer m_basic_renderer;
+        vren::pipeline m_pipeline;
 
     public:
         explicit DrawChunkList(Renderer &renderer);
@@ -26,5 +38,8 @@ namespace explo
         void record(VkCommandBuffer cmd_buf, vren::resource_container &resource_container);
 
         vren::render_graph_t create_render_graph_node(vren::render_graph_allocator &allocator);
+
+    private:
+        vren::pipeline create_pipeline();
     };
 }  // namespace explo
@@ -1,10 +1,8 @@
 #include "BlockRegistry.hpp"
 
-#include "video/RenderApi.hpp"
-
 using namespace explo;
 
-BlockRegistry::BlockRegistry()
+BlockRegistry::BlockRegistry(RenderSink &render_sink)
 {
     // TODO Format is ABGR (wtf?)
 
@@ -18,5 +16,5 @@ BlockRegistry::BlockRegistry()
     m_block_data.push_back({.m_color = 0xff7a858c});  // 3 = Stone
     m_block_data.push_back({.m_color = 0xffffffff});  // 4 = Snow
 
-    RenderApi::block_registry_upload(*this);
+    render_sink.block_registry_upload(*this);
 }
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "BlockData.hpp"
+#include "video/RenderSink.hpp"
 
 namespace explo
 {
@@ -13,7 +14,8 @@ namespace explo
         std::vector<BlockData> m_block_data;
 
     public:
-        explicit BlockRegistry();
+        /// Registers the blocks and uploads them to the render sink.
+        explicit BlockRegistry(RenderSink &render_sink);
         ~BlockRegistry() = default;
 
         std::vector<BlockData> const &get_block_data() const { return m_block_data; };
@@ -1,26 +1,87 @@
 #include "Chunk.hpp"
 
-#include <glm/gtc/integer.hpp>
+#include <cassert>
+#include <stdexcept>
 
-#include "Game.hpp"
 #include "World.hpp"
 
 using namespace explo;
 
-Chunk::Chunk(World &world, glm::ivec3 const &position) :
+namespace
+{
+    std::unique_ptr<VolumeStorage> create_volume_storage(VolumeStorageType volume_storage_type)
+    {
+        switch (volume_storage_type)
+        {
+            case VolumeStorageType::Dense:
+                return std::make_unique<DenseVolumeStorage>(Chunk::k_grid_size);
+            case VolumeStorageType::Octree:
+                return std::make_unique<OctreeVolumeStorage>(Chunk::k_grid_size);
+            case VolumeStorageType::Palette:
+                return std::make_unique<PaletteVolumeStorage>(Chunk::k_grid_size);
+        }
+        throw std::runtime_error("Invalid volume storage type");
+    }
+}  // namespace
+
+Chunk::Chunk(World &world, glm::ivec3 const &position, VolumeStorageType volume_storage_type) :
     m_world(world),
-    m_position(position)
+    m_position(position),
+    m_loaded_at(get_steady_nanos()),
+    m_job_token(std::make_shared<JobToken>())
 {
-    uint32_t max_side = std::max(std::max(Chunk::k_grid_size.x, Chunk::k_grid_size.y), Chunk::k_grid_size.z);
-    uint32_t octree_depth = glm::log2(ceil_to_power_of_2(max_side));
-    m_octree = std::make_unique<Octree>(octree_depth);
+    m_volume = create_volume_storage(volume_storage_type);
 }
 
 Chunk::~Chunk() {}
 
-Octree &Chunk::octree() const
+void Chunk::set_volume_storage_type(VolumeStorageType volume_storage_type)
+{
+    if (m_volume->get_type() == volume_storage_type) return;
+
+    std::unique_ptr<VolumeStorage> volume = create_volume_storage(volume_storage_type);
+
+    if (m_volume->get_type() == VolumeStorageType::Octree)
+    {
+        // Copy the octree leaves as boxes, so that merged leaves aren't expanded block by block (e.g. they fill whole palette sections)
+        Octree const &octree = static_cast<OctreeVolumeStorage const &>(*m_volume).octree();
+        for (Octree::Leaf const &leaf : octree.leaves())
+        {
+            int side = 1 << (octree.get_depth() - leaf.m_level - 1);
+            volume->fill_block_type(leaf.m_position, glm::min(leaf.m_position + side, Chunk::k_grid_size), uint8_t(leaf.m_value));
+        }
+    }
+    else
+    {
+        for_each_block(
+            [&](glm::ivec3 const &block_pos, uint8_t block_type)
+            {
+                volume->set_block_type_at(block_pos, block_type);
+            }
+        );
+    }
+    volume->optimize();
+
+    std::lock_guard<std::mutex> lock(m_volume_mutex);
+    m_volume = std::move(volume);
+}
+
+bool Chunk::has_surface() const
+{
+    std::lock_guard<std::mutex> lock(m_surface_mutex);
+    return bool(m_surface);
+}
+
+std::shared_ptr<Surface const> Chunk::get_surface() const
 {
-    return *m_octree;
+    std::lock_guard<std::mutex> lock(m_surface_mutex);
+    return m_surface;
+}
+
+uint8_t Chunk::get_surface_neighbour_mask() const
+{
+    std::lock_guard<std::mutex> lock(m_surface_mutex);
+    return m_surface_neighbour_mask;
 }
 
 glm::ivec3 Chunk::to_world_block_position(glm::ivec3 const &chunk_block_pos) const
@@ -51,14 +112,29 @@ glm::vec3 Chunk::to_chunk_position(glm::vec3 const &world_pos)
 
 uint8_t Chunk::get_block_type_at(glm::ivec3 const &block_pos) const
 {
-    if (Chunk::test_chunk_block_position(block_pos)) return 0;  // TODO if the block coord is not inside the chunk, throw an error instead!
-    return m_octree->get_voxel_at(Octree::to_morton_code(block_pos));
+    if (!Chunk::test_chunk_block_position(block_pos)) return 0;
+    return m_volume->get_block_type_at(block_pos);
 }
 
 void Chunk::set_block_type_at(glm::ivec3 const &block_pos, uint8_t block_type)
 {
     assert(Chunk::test_chunk_block_position(block_pos));
-    return m_octree->set_voxel_at(Octree::to_morton_code(block_pos), block_type);
+    m_volume->set_block_type_at(block_pos, block_type);
+}
+
+void Chunk::fill_block_type(glm::ivec3 const &from, glm::ivec3 const &to, uint8_t block_type)
+{
+    glm::ivec3 clamped_from = glm::max(from, glm::ivec3(0));
+    glm::ivec3 clamped_to = glm::min(to, Chunk::k_grid_size);
+
+    if (clamped_from.x >= clamped_to.x || clamped_from.y >= clamped_to.y || clamped_from.z >= clamped_to.z) return;
+
+    m_volume->fill_block_type(clamped_from, clamped_to, block_type);
+}
+
+void Chunk::fill_block_type_column(int x, int z, int from_y, int to_y, uint8_t block_type)
+{
+    fill_block_type(glm::ivec3(x, from_y, z), glm::ivec3(x + 1, to_y, z + 1), block_type);
 }
 
 bool Chunk::test_chunk_block_position(glm::ivec3 const &chunk_block_pos)
@@ -1,15 +1,19 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <functional>
 #include <glm/glm.hpp>
 #include <mutex>
 #include <optional>
 #include <vector>
-#include <vren/model/model.hpp>
 
+#include "util/JobToken.hpp"
+#include "util/TaskGraph.hpp"
 #include "world/surface/SurfaceGenerator.hpp"
-#include "world/volume/Octree.hpp"
+#include "world/volume/DenseVolumeStorage.hpp"
+#include "world/volume/OctreeVolumeStorage.hpp"
+#include "world/volume/PaletteVolumeStorage.hpp"
 #include "world/volume/VolumeGenerator.hpp"
 
 namespace explo
@@ -22,9 +26,6 @@ namespace explo
 
     // ------------------------------------------------------------------------------------------------
 
-    /* Surface */
-    using chunk_surface_t = vren::model;
-
     /* Block */
     using block_t = uint8_t;
 
@@ -32,6 +33,7 @@ namespace explo
     {
         friend class World;
         friend class WorldView;
+        friend class ChunkMetrics;
         friend class BakedWorldView;
         friend class VolumeGenerator;
         friend class SurfaceGenerator;
@@ -45,25 +47,70 @@ namespace explo
         World &m_world;
         glm::ivec3 m_position;
 
+        /// Held while the volume is read on behalf of another chunk (e.g. to copy the borders) and while its storage is replaced.
         mutable std::mutex m_volume_mutex;
-        std::unique_ptr<Octree> m_octree;
+        std::unique_ptr<VolumeStorage> m_volume;
+        std::atomic<bool> m_has_volume = false;
+
+        mutable std::mutex m_surface_mutex;
+        std::shared_ptr<Surface const> m_surface;
+        uint8_t m_surface_neighbour_mask = 0;  ///< The neighbours (a bit per BlockFace) available when the surface was generated
+
+        /// Called, from the thread that generated it, every time the surface is (re)generated.
+        std::function<void(std::shared_ptr<Chunk> const &)> m_surface_callback;
+
+        uint64_t m_loaded_at;  ///< Read from get_steady_nanos(), the stage latencies of ChunkMetrics are measured from it
+        std::atomic<bool> m_uploaded = false;
 
-        std::unique_ptr<Surface> m_surface;
+        /// Shared by the generation jobs of the chunk: prioritizes them and cancels them once the chunk is unloaded.
+        std::shared_ptr<JobToken> m_job_token;
+
+        /// The task generating the volume, that the surface tasks of the neighbours loaded afterwards wait for (only accessed by the
+        /// thread loading the chunks).
+        std::shared_ptr<Task> m_volume_task;
 
     public:
-        explicit Chunk(World &world, glm::ivec3 const &position);
+        explicit Chunk(World &world, glm::ivec3 const &position, VolumeStorageType volume_storage_type = VolumeStorageType::Octree);
         ~Chunk();
 
         World &get_world() const { return m_world; }
         glm::ivec3 const &get_position() const { return m_position; }
 
-        Octree &octree() const;
+        VolumeStorage &get_volume() const { return *m_volume; }
+        VolumeStorageType get_volume_storage_type() const { return m_volume->get_type(); }
+
+        /// Moves the blocks to a storage of the given type (does nothing if the chunk already uses it).
+        void set_volume_storage_type(VolumeStorageType volume_storage_type);
 
+        /// Calls the visitor, taking the block position (relative to the chunk) and the block type, for every non-empty block.
+        template <typename _VisitorT>
+        void for_each_block(_VisitorT &&visitor) const;
+
+        /// Returns the block type at the given position, relative to the chunk. Positions outside of the chunk are air.
         uint8_t get_block_type_at(glm::ivec3 const &block_pos) const;
         void set_block_type_at(glm::ivec3 const &block_pos, uint8_t block_type);
 
-        bool has_surface() const { return bool(m_surface); };
-        std::unique_ptr<Surface> const &get_surface() const { return m_surface; }
+        /// Sets the block type of every block within the box [from, to), relative to the chunk. The box is clamped to the chunk.
+        void fill_block_type(glm::ivec3 const &from, glm::ivec3 const &to, uint8_t block_type);
+
+        /// Sets the block type of the vertical run of blocks [from_y, to_y) at the given column, relative to the chunk.
+        void fill_block_type_column(int x, int z, int from_y, int to_y, uint8_t block_type);
+
+        std::shared_ptr<JobToken> const &get_job_token() const { return m_job_token; }
+
+        uint64_t get_loaded_at() const { return m_loaded_at; }
+
+        /// Whether the volume has been generated (set once, the blocks aren't expected to change afterwards).
+        bool has_volume() const { return m_has_volume; }
+
+        bool has_surface() const;
+
+        /// Returns the latest surface of the chunk. The surface can be regenerated at any time (e.g. when a neighbour is generated), hence
+        /// the ownership is shared with the caller.
+        std::shared_ptr<Surface const> get_surface() const;
+
+        /// Returns the neighbours (a bit per BlockFace) that were considered when generating the current surface.
+        uint8_t get_surface_neighbour_mask() const;
 
         glm::uvec3 const &get_grid_size() const { return k_grid_size; }
 
@@ -79,4 +126,22 @@ namespace explo
 
         static glm::ivec3 get_position(glm::ivec3 const &block_pos);
     };
+
+    template <typename _VisitorT>
+    void Chunk::for_each_block(_VisitorT &&visitor) const
+    {
+        // Dispatch once per chunk, so that the visitor can be inlined in the storage loop
+        switch (m_volume->get_type())
+        {
+            case VolumeStorageType::Dense:
+                static_cast<DenseVolumeStorage const &>(*m_volume).for_each_block(visitor);
+                break;
+            case VolumeStorageType::Octree:
+                static_cast<OctreeVolumeStorage const &>(*m_volume).for_each_block(visitor);
+                break;
+            case VolumeStorageType::Palette:
+                static_cast<PaletteVolumeStorage const &>(*m_volume).for_each_block(visitor);
+                break;
+        }
+    }
 }  // namespace explo
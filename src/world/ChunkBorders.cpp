@@ -0,0 +1,67 @@
+#include "ChunkBorders.hpp"
+
+#include "Chunk.hpp"
+
+using namespace explo;
+
+size_t ChunkBorders::to_layer_index(BlockFace face, glm::ivec3 const &block_pos)
+{
+    // The layer is spanned by the two axes orthogonal to the face normal
+    int d = face / 2;
+    int u = (d + 1) % 3;
+    int v = (d + 2) % 3;
+    return size_t(block_pos[v]) * Chunk::k_grid_size[u] + block_pos[u];
+}
+
+void ChunkBorders::set_neighbour(BlockFace face, Chunk const &neighbour)
+{
+    int d = face / 2;
+    int u = (d + 1) % 3;
+    int v = (d + 2) % 3;
+
+    std::vector<uint8_t> &layer = m_layers[face];
+    layer.resize(size_t(Chunk::k_grid_size[u]) * Chunk::k_grid_size[v]);
+
+    // The layer of the neighbour touching the chunk is its last one for the negative faces, the first one for the positive faces
+    glm::ivec3 block_pos{};
+    block_pos[d] = (face % 2) == 0 ? Chunk::k_grid_size[d] - 1 : 0;
+    for (block_pos[v] = 0; block_pos[v] < Chunk::k_grid_size[v]; block_pos[v]++)
+    {
+        for (block_pos[u] = 0; block_pos[u] < Chunk::k_grid_size[u]; block_pos[u]++)
+            layer[to_layer_index(face, block_pos)] = neighbour.get_block_type_at(block_pos);
+    }
+
+    m_neighbour_mask |= 1 << face;
+}
+
+uint8_t ChunkBorders::get_block_type_at(glm::ivec3 const &block_pos) const
+{
+    int face = -1;
+    for (int d = 0; d < 3; d++)
+    {
+        bool below = block_pos[d] < 0;
+        bool above = block_pos[d] >= Chunk::k_grid_size[d];
+        if (!below && !above) continue;
+
+        if (face >= 0) return 0;  // Outside along more than one axis: not facing the chunk
+        face = d * 2 + (above ? 1 : 0);
+    }
+
+    if (face < 0 || !has_neighbour(BlockFace(face))) return 0;
+    if (block_pos[face / 2] != -1 && block_pos[face / 2] != Chunk::k_grid_size[face / 2]) return 0;  // Not touching the chunk
+
+    return m_layers[face][to_layer_index(BlockFace(face), block_pos)];
+}
+
+uint8_t ChunkBorders::get_block_type_at(Chunk const &chunk, glm::ivec3 const &block_pos) const
+{
+    if (Chunk::test_chunk_block_position(block_pos)) return chunk.get_block_type_at(block_pos);
+    return get_block_type_at(block_pos);
+}
+
+glm::ivec3 ChunkBorders::get_face_normal(BlockFace face)
+{
+    glm::ivec3 normal(0);
+    normal[face / 2] = (face % 2) == 0 ? -1 : 1;
+    return normal;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "world/surface/Surface.hpp"
+
+namespace explo
+{
+    // Forward decl
+    class Chunk;
+
+    /// A read-only copy of the blocks surrounding a chunk: for every face of the chunk, the layer of the neighbouring chunk touching it.
+    /// It's taken before meshing so that the border faces hidden by the neighbours aren't generated. Missing neighbours are air.
+    class ChunkBorders
+    {
+    private:
+        std::array<std::vector<uint8_t>, BlockFace_Count> m_layers;  ///< Empty if the neighbour is missing
+        uint8_t m_neighbour_mask = 0;
+
+    public:
+        explicit ChunkBorders() = default;
+        ~ChunkBorders() = default;
+
+        /// Copies the layer of the given neighbour that touches the given face of the chunk. The neighbour volume must not be written
+        /// meanwhile.
+        void set_neighbour(BlockFace face, Chunk const &neighbour);
+
+        bool has_neighbour(BlockFace face) const { return ((m_neighbour_mask >> face) & 1) != 0; }
+
+        /// A bit per BlockFace, set if the neighbour at that face is available.
+        uint8_t get_neighbour_mask() const { return m_neighbour_mask; }
+
+        /// Returns the block type at the given position, relative to the chunk, that is expected to be outside of it. Only the blocks
+        /// facing the chunk faces are known, the others (e.g. diagonal neighbours) are air.
+        uint8_t get_block_type_at(glm::ivec3 const &block_pos) const;
+
+        /// Returns the block type at the given position relative to the chunk, reading the chunk if the position is inside of it, the
+        /// borders otherwise.
+        uint8_t get_block_type_at(Chunk const &chunk, glm::ivec3 const &block_pos) const;
+
+        static glm::ivec3 get_face_normal(BlockFace face);
+        static BlockFace get_opposite_face(BlockFace face) { return BlockFace(face ^ 1); }
+
+    private:
+        static size_t to_layer_index(BlockFace face, glm::ivec3 const &block_pos);
+    };
+}  // namespace explo
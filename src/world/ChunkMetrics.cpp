@@ -0,0 +1,108 @@
+#include "ChunkMetrics.hpp"
+
+#include "Chunk.hpp"
+#include "util/misc.hpp"
+
+using namespace explo;
+
+namespace
+{
+    void write_histogram_json(std::ostream &stream, LatencyHistogram const &histogram)
+    {
+        stream << "{\"count\": " << histogram.get_count();
+        stream << ", \"mean_ms\": " << histogram.get_mean_ms();
+        stream << ", \"p50_ms\": " << histogram.get_quantile_ms(0.50);
+        stream << ", \"p95_ms\": " << histogram.get_quantile_ms(0.95);
+        stream << ", \"p99_ms\": " << histogram.get_quantile_ms(0.99);
+        stream << ", \"max_ms\": " << histogram.get_max_ms() << "}";
+    }
+
+    void write_profile_stats_json(std::ostream &stream, concurrent_profile_stats const &stats)
+    {
+        stream << "{\"count\": " << stats.sample_count();
+        stream << ", \"min_ms\": " << (stats.sample_count() > 0 ? stats.min_ms() : 0.0);
+        stream << ", \"mean_ms\": " << stats.avg_ms();
+        stream << ", \"p50_ms\": " << stats.quantile_ms(0.50);
+        stream << ", \"p95_ms\": " << stats.quantile_ms(0.95);
+        stream << ", \"p99_ms\": " << stats.quantile_ms(0.99);
+        stream << ", \"max_ms\": " << stats.max_ms() << "}";
+    }
+}  // namespace
+
+void ChunkMetrics::record_stage(Chunk const &chunk, ChunkStage stage)
+{
+    m_stage_latencies[stage].record(get_steady_nanos() - chunk.get_loaded_at());
+}
+
+void ChunkMetrics::record_upload(Chunk &chunk)
+{
+    if (!chunk.m_uploaded.exchange(true, std::memory_order_relaxed)) record_stage(chunk, ChunkStage_Uploaded);
+    else m_reupload_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+ChunkMetrics::Counters ChunkMetrics::get_counters() const
+{
+    return Counters{
+        .m_cancelled_count = m_cancelled_count.load(std::memory_order_relaxed),
+        .m_stale_count = m_stale_count.load(std::memory_order_relaxed),
+        .m_surface_regeneration_count = m_surface_regeneration_count.load(std::memory_order_relaxed),
+        .m_reupload_count = m_reupload_count.load(std::memory_order_relaxed),
+    };
+}
+
+void ChunkMetrics::reset()
+{
+    for (LatencyHistogram &stage_latency : m_stage_latencies) stage_latency.reset();
+
+    m_volume_generation_time.reset();
+    m_surface_generation_time.reset();
+
+    m_cancelled_count.store(0, std::memory_order_relaxed);
+    m_stale_count.store(0, std::memory_order_relaxed);
+    m_surface_regeneration_count.store(0, std::memory_order_relaxed);
+    m_reupload_count.store(0, std::memory_order_relaxed);
+}
+
+void ChunkMetrics::write_json(std::ostream &stream) const
+{
+    stream << "{\n  \"stages\": {\n";
+    for (uint32_t stage = 0; stage < ChunkStage_Count; stage++)
+    {
+        stream << "    \"" << get_stage_name(ChunkStage(stage)) << "\": ";
+        write_histogram_json(stream, m_stage_latencies[stage]);
+        stream << (stage + 1 < ChunkStage_Count ? ",\n" : "\n");
+    }
+    stream << "  },\n";
+
+    stream << "  \"volume_generation_time\": ";
+    write_profile_stats_json(stream, m_volume_generation_time);
+    stream << ",\n  \"surface_generation_time\": ";
+    write_profile_stats_json(stream, m_surface_generation_time);
+    stream << ",\n";
+
+    Counters counters = get_counters();
+    stream << "  \"cancelled\": " << counters.m_cancelled_count << ",\n";
+    stream << "  \"stale\": " << counters.m_stale_count << ",\n";
+    stream << "  \"surface_regenerations\": " << counters.m_surface_regeneration_count << ",\n";
+    stream << "  \"reuploads\": " << counters.m_reupload_count << "\n";
+    stream << "}\n";
+}
+
+char const *ChunkMetrics::get_stage_name(ChunkStage stage)
+{
+    switch (stage)
+    {
+        case ChunkStage_Queued:
+            return "queued";
+        case ChunkStage_VolumeGenerated:
+            return "volume_generated";
+        case ChunkStage_SurfaceGenerated:
+            return "surface_generated";
+        case ChunkStage_Uploaded:
+            return "uploaded";
+        case ChunkStage_Destroyed:
+            return "destroyed";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+#include "util/LatencyHistogram.hpp"
+#include "util/profile_stats.hpp"
+
+namespace explo
+{
+    // Forward decl
+    class Chunk;
+
+    /// The stages of the chunk lifecycle, in order.
+    enum ChunkStage : uint8_t
+    {
+        ChunkStage_Queued = 0,         ///< A worker started generating the chunk (the latency is the time spent in the queue)
+        ChunkStage_VolumeGenerated,    ///< The volume is generated
+        ChunkStage_SurfaceGenerated,   ///< The first surface is generated, against the neighbours available
+        ChunkStage_Uploaded,           ///< The chunk is first uploaded for rendering (the pop-in latency)
+        ChunkStage_Destroyed,          ///< The chunk is unloaded (the latency is its lifetime)
+
+        ChunkStage_Count
+    };
+
+    /// The metrics of the chunk pipeline: for every stage, a histogram of the time since the chunk was loaded, and the time spent
+    /// generating the volume and the surface. Recording is lock-free, the generation jobs record from the workers.
+    class ChunkMetrics
+    {
+    public:
+        struct Counters
+        {
+            uint64_t m_cancelled_count;             ///< The chunks unloaded before their surface was generated
+            uint64_t m_stale_count;                 ///< The generation stages that completed after the chunk was unloaded
+            uint64_t m_surface_regeneration_count;  ///< The surfaces generated again as a neighbour got generated
+            uint64_t m_reupload_count;              ///< The uploads following the first one (e.g. after a surface regeneration)
+        };
+
+    private:
+        std::array<LatencyHistogram, ChunkStage_Count> m_stage_latencies;
+
+        concurrent_profile_stats m_volume_generation_time;
+        concurrent_profile_stats m_surface_generation_time;
+
+        std::atomic<uint64_t> m_cancelled_count = 0;
+        std::atomic<uint64_t> m_stale_count = 0;
+        std::atomic<uint64_t> m_surface_regeneration_count = 0;
+        std::atomic<uint64_t> m_reupload_count = 0;
+
+    public:
+        explicit ChunkMetrics() = default;
+        ~ChunkMetrics() = default;
+
+        /// Records that the chunk reached the given stage, now.
+        void record_stage(Chunk const &chunk, ChunkStage stage);
+
+        /// Records the upload of the chunk for rendering: its first upload reaches ChunkStage_Uploaded, the following are counted as
+        /// reuploads. Called by the render sinks.
+        void record_upload(Chunk &chunk);
+
+        void record_volume_generation_time(uint64_t elapsed_ns) { m_volume_generation_time.push_elapsed_time(elapsed_ns); }
+        void record_surface_generation_time(uint64_t elapsed_ns) { m_surface_generation_time.push_elapsed_time(elapsed_ns); }
+
+        void record_cancelled() { m_cancelled_count.fetch_add(1, std::memory_order_relaxed); }
+        void record_stale() { m_stale_count.fetch_add(1, std::memory_order_relaxed); }
+        void record_surface_regeneration() { m_surface_regeneration_count.fetch_add(1, std::memory_order_relaxed); }
+
+        LatencyHistogram const &get_stage_latency(ChunkStage stage) const { return m_stage_latencies[stage]; }
+        concurrent_profile_stats const &get_volume_generation_time() const { return m_volume_generation_time; }
+        concurrent_profile_stats const &get_surface_generation_time() const { return m_surface_generation_time; }
+
+        Counters get_counters() const;
+
+        /// Clears every metric. Not atomic: samples recorded meanwhile could be partially kept.
+        void reset();
+
+        /// Writes the metrics as JSON (the latencies in milliseconds), e.g. to graph the pop-in latency across runs.
+        void write_json(std::ostream &stream) const;
+
+        static char const *get_stage_name(ChunkStage stage);
+    };
+}  // namespace explo
@@ -1,38 +1,87 @@
 #pragma once
 
-#include <functional>
 #include <glm/glm.hpp>
-#include <unordered_set>
-
-#include "util/misc.hpp"
+#include <utility>
 
 namespace explo
 {
+    /// Iterates the chunks of the world view at the new center that weren't part of the world view at the old center, each of them
+    /// exactly once. Swapping the centers iterates the chunks that left the world view.
+    ///
+    /// The chunks are enumerated as (at most) three disjoint slabs, one per axis of movement: the slab of an axis holds the chunks beyond
+    /// the old world view along that axis, but within it along the axes handled before. No chunk has to be remembered.
+    template <typename _CallbackT>
     class DeltaChunkIterator
     {
-    public:
-        using CallbackT = std::function<void(glm::ivec3 const &)>;
-
     private:
         glm::ivec3 m_old_center;
         glm::ivec3 m_new_center;
         glm::ivec3 m_render_distance;
-        CallbackT m_callback;
-
-        /// A set holding the chunks for which the callback was called (very simple and stupid approach).
-        std::unordered_set<glm::ivec3, vec_hash> m_visited_chunks;
+        _CallbackT m_callback;
 
     public:
         explicit DeltaChunkIterator(
-            glm::ivec3 const &old_center, glm::ivec3 const &new_center, glm::ivec3 const &render_distance, CallbackT const &callback
-        );
-        ~DeltaChunkIterator();
+            glm::ivec3 const &old_center, glm::ivec3 const &new_center, glm::ivec3 const &render_distance, _CallbackT callback
+        ) :
+            m_old_center(old_center),
+            m_new_center(new_center),
+            m_render_distance(render_distance),
+            m_callback(std::move(callback))
+        {
+        }
+
+        ~DeltaChunkIterator() = default;
 
         /// Iterates over the new chunks according to the shift given by world view's old center and new center.
-        void iterate();
+        void iterate()
+        {
+            glm::ivec3 old_min = m_old_center - m_render_distance;
+            glm::ivec3 old_max = m_old_center + m_render_distance;
+
+            // The part of the new world view not iterated yet
+            glm::ivec3 min = m_new_center - m_render_distance;
+            glm::ivec3 max = m_new_center + m_render_distance;
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                if (m_new_center[axis] == m_old_center[axis]) continue;
+
+                iterate_slab(axis, old_min, old_max, min, max);
+
+                // What's left is within the old world view along this axis
+                min[axis] = glm::max(min[axis], old_min[axis]);
+                max[axis] = glm::min(max[axis], old_max[axis]);
+                if (min[axis] > max[axis]) return;  // The world views don't overlap, the slab was the whole new world view
+            }
+        }
 
     private:
-        void iterate_along_axis(int axis);
+        /// Iterates the chunks of [min, max] beyond the old world view along the axis, from the closest to the farthest.
+        void iterate_slab(int axis, glm::ivec3 const &old_min, glm::ivec3 const &old_max, glm::ivec3 const &min, glm::ivec3 const &max)
+        {
+            int ax0 = axis;  // The axis of movement
+            int ax1 = (axis + 1) % 3;
+            int ax2 = (axis + 2) % 3;
+
+            int step = m_new_center[axis] > m_old_center[axis] ? 1 : -1;
+            int from = step > 0 ? glm::max(old_max[ax0] + 1, min[ax0]) : glm::min(old_min[ax0] - 1, max[ax0]);
+            int to = step > 0 ? max[ax0] + 1 : min[ax0] - 1;
+
+            glm::ivec3 chunk_pos{};
+            for (int c = from; c != to; c += step)
+            {
+                chunk_pos[ax0] = c;
+                for (int a = min[ax1]; a <= max[ax1]; a++)
+                {
+                    chunk_pos[ax1] = a;
+                    for (int b = min[ax2]; b <= max[ax2]; b++)
+                    {
+                        chunk_pos[ax2] = b;
+                        m_callback(chunk_pos);
+                    }
+                }
+            }
+        }
     };
 
-}  // namespace explo
\ No newline at end of file
+}  // namespace explo
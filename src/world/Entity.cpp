@@ -1,11 +1,10 @@
 #include "Entity.hpp"
 
-#include "video/RenderApi.hpp"
-
 using namespace explo;
 
-Entity::Entity(World &world, glm::vec3 const &init_position) :
+Entity::Entity(World &world, RenderSink &render_sink, glm::vec3 const &init_position) :
     m_world(&world),
+    m_render_sink(&render_sink),
     m_position(init_position),
     m_yaw(0.0f),
     m_pitch(0.0f)
@@ -58,6 +57,8 @@ void Entity::set_rotation(float yaw, float pitch)
     m_pitch = pitch;
 
     update_orientation_matrix();
+
+    if (m_world_view) m_world_view->set_view_direction(get_forward());
 }
 
 void Entity::update_orientation_matrix()
@@ -87,10 +88,7 @@ bool Entity::has_world_view() const
 
 WorldView &Entity::recreate_world_view(glm::ivec3 const &render_distance)
 {
-    glm::ivec3 pos = get_chunk_position();
-
-    RenderApi::world_view_recreate(pos, render_distance);
-    m_world_view = std::make_unique<WorldView>(*m_world, pos, render_distance);
+    m_world_view = std::make_unique<WorldView>(*m_world, *m_render_sink, get_chunk_position(), render_distance, get_forward());
 
     return *m_world_view;
 }
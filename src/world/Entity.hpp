@@ -13,6 +13,7 @@ namespace explo
     {
     private:
         World *m_world;
+        RenderSink *m_render_sink;  ///< The world view uploads to it
 
         glm::vec3 m_position;
 
@@ -25,7 +26,7 @@ namespace explo
     public:
         inline static glm::vec3 k_camera_offset = glm::vec3(0, 2 /* Entity's height */, 0);
 
-        explicit Entity(World &world, glm::vec3 const &init_position = glm::vec3(0));
+        explicit Entity(World &world, RenderSink &render_sink, glm::vec3 const &init_position = glm::vec3(0));
         ~Entity();
 
         World &get_world() { return *m_world; };
@@ -1,106 +1,343 @@
 #include "World.hpp"
 
 #include <memory>
+#include <stdexcept>
 
-#include "Game.hpp"
 #include "log.hpp"
-#include "util/JobChain.hpp"
+#include "util/Profiler.hpp"
+#include "util/TaskGraph.hpp"
 
 using namespace explo;
 
-World::World(VolumeGenerator &volume_generator, SurfaceGenerator &surface_generator) :
+World::World(VolumeGenerator &volume_generator, SurfaceGenerator &surface_generator, ThreadPool &thread_pool) :
     m_volume_generator(volume_generator),
-    m_surface_generator(surface_generator)
+    m_surface_generator(surface_generator),
+    m_thread_pool(thread_pool)
 {
 }
 
 World::~World() {}
 
+bool World::is_chunk_loaded(glm::ivec3 const &chunk_pos) const
+{
+    return m_chunks.contains(chunk_pos);
+}
+
+size_t World::get_loaded_chunk_count() const
+{
+    return m_chunks.size();
+}
+
+std::shared_ptr<Chunk> World::get_chunk(glm::ivec3 const &chunk_pos)
+{
+    std::optional<std::shared_ptr<Chunk>> chunk = m_chunks.find(chunk_pos);
+    if (!chunk) throw std::out_of_range("Chunk not loaded");
+    return *chunk;
+}
+
+std::shared_ptr<Chunk> World::find_chunk(glm::ivec3 const &chunk_pos) const
+{
+    return m_chunks.find(chunk_pos).value_or(nullptr);
+}
+
+World::ChunkNeighboursT World::get_chunk_neighbours(glm::ivec3 const &chunk_pos) const
+{
+    ChunkNeighboursT neighbours{};
+    for (uint32_t face = 0; face < BlockFace_Count; face++)
+        neighbours[face] = find_chunk(chunk_pos + ChunkBorders::get_face_normal(BlockFace(face)));
+    return neighbours;
+}
+
 std::pair<Chunk &, bool> World::load_chunk_async(glm::ivec3 const &chunk_pos, ChunkLoadedCallbackT const &callback)
 {
-    std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>(*this, chunk_pos);
-    auto [iterator, inserted] = m_chunks.emplace(chunk_pos, chunk);
+    VolumeStorageType volume_storage_type =
+        m_volume_storage_policy == VolumeStoragePolicy::AlwaysOctree ? VolumeStorageType::Octree : VolumeStorageType::Dense;
+
+    std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>(*this, chunk_pos, volume_storage_type);
+    chunk->m_surface_callback = callback;
+    chunk->m_job_token->set_priority(get_chunk_priority(m_priority_center, m_priority_direction, chunk_pos));
 
-    if (!inserted) return {*iterator->second.get(), false};  // Chunk already loaded
+    auto [loaded_chunk, inserted] = m_chunks.emplace(chunk_pos, chunk);
+    if (!inserted) return {*loaded_chunk, false};  // Chunk already loaded
 
-    generate_chunk_async(chunk, callback);
+    generate_chunk_async(chunk);
 
     return {*chunk, true};
 }
 
 bool World::unload_chunk(glm::ivec3 const &chunk_pos)
 {
-    auto chunk_it = m_chunks.find(chunk_pos);
-    if (chunk_it == m_chunks.end()) return false;  // Chunk wasn't loaded
+    std::optional<std::shared_ptr<Chunk>> chunk = m_chunks.extract(chunk_pos);
+    if (!chunk) return false;  // Chunk wasn't loaded
 
-    std::shared_ptr<Chunk> chunk = chunk_it->second;
-    return m_chunks.erase(chunk_pos) == 1;
+    (*chunk)->m_job_token->cancel();
+
+    m_chunk_metrics.record_stage(**chunk, ChunkStage_Destroyed);
+    if (!(*chunk)->has_surface()) m_chunk_metrics.record_cancelled();
+
+    return true;
 }
 
-void World::generate_chunk_surface(Chunk &chunk)
+void World::set_priority_center(glm::ivec3 const &chunk_pos)
 {
-    // TODO Volume generation shall not take place while the surface is being generated
+    if (chunk_pos == m_priority_center) return;
 
-    uint64_t started_at = current_ms();
+    m_priority_center = chunk_pos;
+    update_chunk_priorities();
+}
 
-    Surface surface;
-    SurfaceWriter surface_writer(surface);
+void World::set_priority_direction(glm::vec3 const &direction)
+{
+    constexpr float k_min_turn_cos = 0.9f;  // ~25 degrees
 
-    m_surface_generator.generate(chunk, surface_writer);
+    glm::vec3 normalized_direction = glm::length(direction) > 0.0f ? glm::normalize(direction) : glm::vec3(0);
 
-    chunk.m_surface = std::make_unique<Surface>(std::move(surface));
+    bool was_none = m_priority_direction == glm::vec3(0);
+    bool is_none = normalized_direction == glm::vec3(0);
+    if (was_none == is_none && (is_none || glm::dot(normalized_direction, m_priority_direction) >= k_min_turn_cos)) return;
 
-    glm::ivec3 chunk_pos = chunk.get_position();
+    m_priority_direction = normalized_direction;
+    update_chunk_priorities();
 }
 
-void World::generate_chunk_async(std::shared_ptr<Chunk> const &chunk, ChunkLoadedCallbackT const &callback)
+void World::update_chunk_priorities()
 {
-    JobChain job_chain{};
-    job_chain
-        // Generate the volume
-        .then(
-            [weak_world = weak_from_this(), weak_chunk = std::weak_ptr(chunk)]()
-            {
-                std::shared_ptr<World> world = weak_world.lock();
-                std::shared_ptr<Chunk> chunk = weak_chunk.lock();
+    m_chunks.for_each(
+        [this](glm::ivec3 const &position, std::shared_ptr<Chunk> const &chunk)
+        {
+            chunk->m_job_token->set_priority(get_chunk_priority(m_priority_center, m_priority_direction, position));
+        }
+    );
+
+    m_thread_pool.update_priorities();
+}
 
-                if (!world || !chunk) return;
+float World::get_chunk_priority(glm::ivec3 const &priority_center, glm::vec3 const &priority_direction, glm::ivec3 const &chunk_pos)
+{
+    glm::vec3 offset(chunk_pos - priority_center);
 
-                uint64_t started_at = current_ms();
+    float distance_squared = glm::dot(offset, offset);
+    if (distance_squared == 0.0f || priority_direction == glm::vec3(0)) return distance_squared;
 
-                world->m_volume_generator.generate_volume(*chunk);
+    // The cosine of the angle between the offset and the direction
+    float cos_angle = glm::dot(offset, priority_direction) / glm::sqrt(distance_squared);
+    return distance_squared * (1.0f - k_priority_direction_weight * cos_angle);
+}
 
-                glm::ivec3 chunk_pos = chunk->get_position();
-                LOG_D("World", "Volume generated; Chunk: ({}, {}, {}), dt: {}", chunk_pos.x, chunk_pos.y, chunk_pos.z, current_ms() - started_at);
-            }
-        )
-        // Generate the surface
-        .then(
-            [weak_world = weak_from_this(), weak_chunk = std::weak_ptr(chunk)]()
+ChunkBorders World::get_chunk_borders(glm::ivec3 const &chunk_pos) const
+{
+    ChunkNeighboursT neighbours = get_chunk_neighbours(chunk_pos);
+
+    ChunkBorders borders{};
+    for (uint32_t face = 0; face < BlockFace_Count; face++)
+    {
+        std::shared_ptr<Chunk> const &neighbour = neighbours[face];
+        if (!neighbour || !neighbour->has_volume()) continue;
+
+        std::lock_guard<std::mutex> lock(neighbour->m_volume_mutex);
+        borders.set_neighbour(BlockFace(face), *neighbour);
+    }
+    return borders;
+}
+
+uint8_t World::get_available_neighbour_mask(glm::ivec3 const &chunk_pos) const
+{
+    ChunkNeighboursT neighbours = get_chunk_neighbours(chunk_pos);
+
+    uint8_t neighbour_mask = 0;
+    for (uint32_t face = 0; face < BlockFace_Count; face++)
+    {
+        std::shared_ptr<Chunk> const &neighbour = neighbours[face];
+        if (neighbour && neighbour->has_volume()) neighbour_mask |= 1 << face;
+    }
+    return neighbour_mask;
+}
+
+uint8_t World::generate_chunk_surface(Chunk &chunk)
+{
+    while (true)
+    {
+        ChunkBorders borders = get_chunk_borders(chunk.get_position());
+
+        auto surface = std::make_shared<Surface>();
+        SurfaceWriter surface_writer(*surface);
+
+        {
+            // The chunk could be meshed again by a neighbour while its storage is being converted
+            std::lock_guard<std::mutex> lock(chunk.m_volume_mutex);
+            m_surface_generator.generate(chunk, borders, surface_writer);
+        }
+
+        uint8_t neighbour_mask = borders.get_neighbour_mask();
+        bool is_up_to_date = neighbour_mask == get_available_neighbour_mask(chunk.get_position());
+
+        std::lock_guard<std::mutex> lock(chunk.m_surface_mutex);
+
+        // The chunk could be meshed concurrently (by its surface task and by a neighbour): a surface meshed against fewer neighbours
+        // than the stored one is outdated and must not replace it, as the newer neighbours could have skipped re-meshing the chunk. It's
+        // kept if it considers all of the available neighbours though, the stored one having been meshed against since unloaded ones
+        bool is_newer = (neighbour_mask & chunk.m_surface_neighbour_mask) == chunk.m_surface_neighbour_mask;
+        if (is_newer || is_up_to_date || chunk.m_job_token->is_cancelled())
+        {
+            // Recorded before the surface is published, as from then on a neighbour could regenerate it and upload the chunk
+            if (!chunk.m_surface) m_chunk_metrics.record_stage(chunk, ChunkStage_SurfaceGenerated);
+
+            chunk.m_surface = std::move(surface);
+            chunk.m_surface_neighbour_mask = neighbour_mask;
+
+            return neighbour_mask;
+        }
+    }
+}
+
+void World::regenerate_neighbour_surfaces_async(Chunk const &chunk)
+{
+    ChunkNeighboursT neighbours = get_chunk_neighbours(chunk.get_position());
+    for (uint32_t face = 0; face < BlockFace_Count; face++)
+    {
+        std::shared_ptr<Chunk> const &neighbour = neighbours[face];
+        if (!neighbour || !neighbour->has_surface()) continue;  // Not meshed yet, it will see the chunk
+
+        BlockFace neighbour_face = ChunkBorders::get_opposite_face(BlockFace(face));
+        if ((neighbour->get_surface_neighbour_mask() >> neighbour_face) & 1) continue;  // Already meshed against the chunk
+
+        m_thread_pool.enqueue_job(
+            [weak_world = weak_from_this(), weak_neighbour = std::weak_ptr(neighbour)]()
             {
                 std::shared_ptr<World> world = weak_world.lock();
-                std::shared_ptr<Chunk> chunk = weak_chunk.lock();
+                std::shared_ptr<Chunk> neighbour = weak_neighbour.lock();
 
-                if (!world || !chunk) return;
+                if (!world || !neighbour) return;
 
-                uint64_t started_at = current_ms();
+                PROFILE_SCOPE("World::regenerate_surface");
 
-                world->generate_chunk_surface(*chunk);
+                world->generate_chunk_surface(*neighbour);
+                world->m_chunk_metrics.record_surface_regeneration();
 
-                glm::ivec3 chunk_pos = chunk->get_position();
-                LOG_D("World", "Surface generated; Chunk: ({}, {}, {}), dt: {}", chunk_pos.x, chunk_pos.y, chunk_pos.z, current_ms() - started_at);
-            }
-        )
-        // Call the user provided callback
-        .then(
-            [weak_chunk = std::weak_ptr(chunk), callback]()
+                if (neighbour->m_surface_callback) neighbour->m_surface_callback(neighbour);
+            },
+            neighbour->m_job_token
+        );
+    }
+}
+
+void World::generate_chunk_async(std::shared_ptr<Chunk> const &chunk)
+{
+    TaskGraph task_graph(chunk->m_job_token);
+
+    // Generate the volume
+    std::shared_ptr<Task> volume_task = task_graph.add(
+        [weak_world = weak_from_this(), weak_chunk = std::weak_ptr(chunk)]()
+        {
+            std::shared_ptr<World> world = weak_world.lock();
+            std::shared_ptr<Chunk> chunk = weak_chunk.lock();
+
+            if (!world || !chunk) return;
+
+            PROFILE_SCOPE("World::generate_volume");
+
+            world->m_chunk_metrics.record_stage(*chunk, ChunkStage_Queued);
+
+            uint64_t started_at = get_steady_nanos();
+
+            world->m_volume_generator.generate_volume(*chunk);
+
+            if (chunk->m_job_token->is_cancelled())  // Unloaded meanwhile, the next stages are skipped
             {
-                std::shared_ptr<Chunk> chunk = weak_chunk.lock();
+                world->m_chunk_metrics.record_stale();
+                return;
+            }
+
+            // Most of the chunk is made of solid stone or air: collapse uniform regions to reduce the resident memory
+            chunk->get_volume().optimize();
 
-                if (!chunk) return;
+            chunk->m_has_volume = true;
 
-                callback(chunk);
+            uint64_t elapsed_ns = get_steady_nanos() - started_at;
+            world->m_chunk_metrics.record_volume_generation_time(elapsed_ns);
+            world->m_chunk_metrics.record_stage(*chunk, ChunkStage_VolumeGenerated);
+
+            // The neighbours already meshed have walls facing this chunk that could now be hidden
+            world->regenerate_neighbour_surfaces_async(*chunk);
+
+            glm::ivec3 chunk_pos = chunk->get_position();
+            LOG_D(
+                "World",
+                "Volume generated; Chunk: ({}, {}, {}), dt: {}, volume size: {}",
+                chunk_pos.x,
+                chunk_pos.y,
+                chunk_pos.z,
+                elapsed_ns / 1'000'000,
+                stringify_byte_size(chunk->get_volume().get_byte_size())
+            );
+        }
+    );
+
+    // Generate the surface, once the volume of the chunk and of its loaded neighbours is generated (so that the chunk isn't meshed again
+    // for every neighbour). The neighbours loaded later will mesh the chunk again when their volume is ready
+    SmallVector<std::shared_ptr<Task>, 1 + BlockFace_Count> surface_predecessors{};
+    surface_predecessors.push_back(volume_task);
+    for (std::shared_ptr<Chunk> const &neighbour : get_chunk_neighbours(chunk->get_position()))
+    {
+        if (neighbour && neighbour->m_volume_task) surface_predecessors.push_back(neighbour->m_volume_task);
+    }
+
+    std::shared_ptr<Task> surface_task = task_graph.add(
+        [weak_world = weak_from_this(), weak_chunk = std::weak_ptr(chunk)]()
+        {
+            std::shared_ptr<World> world = weak_world.lock();
+            std::shared_ptr<Chunk> chunk = weak_chunk.lock();
+
+            if (!world || !chunk) return;
+
+            PROFILE_SCOPE("World::generate_surface");
+
+            uint64_t started_at = get_steady_nanos();
+
+            // A neighbour could have been generated while meshing: mesh again until all of the available neighbours are considered
+            uint8_t neighbour_mask;
+            do
+            {
+                neighbour_mask = world->generate_chunk_surface(*chunk);
+            } while (!chunk->m_job_token->is_cancelled() && neighbour_mask != world->get_available_neighbour_mask(chunk->get_position()));
+
+            if (chunk->m_job_token->is_cancelled())
+            {
+                world->m_chunk_metrics.record_stale();
+                return;
             }
-        );
-    job_chain.dispatch(game().m_thread_pool);
+
+            uint64_t elapsed_ns = get_steady_nanos() - started_at;
+            world->m_chunk_metrics.record_surface_generation_time(elapsed_ns);
+
+            // The chunk is built: the dense storage isn't needed anymore for fast lookups, move to a compact storage for residency
+            if (world->m_volume_storage_policy == VolumeStoragePolicy::DenseWhileBuilding)
+                chunk->set_volume_storage_type(VolumeStorageType::Octree);
+            else if (world->m_volume_storage_policy == VolumeStoragePolicy::PaletteResident)
+                chunk->set_volume_storage_type(VolumeStorageType::Palette);
+
+            glm::ivec3 chunk_pos = chunk->get_position();
+            LOG_D("World", "Surface generated; Chunk: ({}, {}, {}), dt: {}", chunk_pos.x, chunk_pos.y, chunk_pos.z, elapsed_ns / 1'000'000);
+        },
+        surface_predecessors
+    );
+
+    // Call the user provided callback (not copied in the job, as copying a std::function could allocate)
+    task_graph.add(
+        [weak_chunk = std::weak_ptr(chunk)]()
+        {
+            std::shared_ptr<Chunk> chunk = weak_chunk.lock();
+
+            if (!chunk) return;
+
+            PROFILE_SCOPE("World::chunk_callback");
+
+            chunk->m_surface_callback(chunk);
+        },
+        {surface_task}
+    );
+
+    chunk->m_volume_task = volume_task;
+
+    task_graph.dispatch(m_thread_pool);
 }
@@ -1,15 +1,27 @@
 #pragma once
 
+#include <array>
 #include <glm/glm.hpp>
 #include <memory>
-#include <unordered_map>
 
 #include "Chunk.hpp"
+#include "ChunkMetrics.hpp"
+#include "util/ShardedMap.hpp"
+#include "util/ThreadPool.hpp"
 #include "util/misc.hpp"
 #include "world/surface/SurfaceGenerator.hpp"
 
 namespace explo
 {
+    /// Decides how chunk blocks are stored along the chunk lifecycle, trading memory for generation speed.
+    enum class VolumeStoragePolicy
+    {
+        AlwaysOctree,        ///< Chunks are generated, meshed and kept resident as octrees (lowest memory)
+        AlwaysDense,         ///< Chunks are generated, meshed and kept resident as dense arrays (fastest, 64KB per chunk)
+        DenseWhileBuilding,  ///< Chunks are dense while being generated and meshed, then converted to octrees for residency
+        PaletteResident      ///< Chunks are dense while being generated and meshed, then converted to palette sections for residency
+    };
+
     class World : public std::enable_shared_from_this<World>
     {
         friend class Chunk;
@@ -17,32 +29,97 @@ namespace explo
 
     public:
         using ChunkLoadedCallbackT = std::function<void(std::shared_ptr<Chunk> const &)>;
+        using ChunkNeighboursT = std::array<std::shared_ptr<Chunk>, BlockFace_Count>;  ///< Indexed by BlockFace
 
     private:
         VolumeGenerator &m_volume_generator;
         SurfaceGenerator &m_surface_generator;
+        ThreadPool &m_thread_pool;  ///< Runs the chunk generation
+
+        VolumeStoragePolicy m_volume_storage_policy = VolumeStoragePolicy::DenseWhileBuilding;
+
+        // Only accessed by the main thread
+        glm::ivec3 m_priority_center = glm::ivec3(0);   ///< The chunks closer to it are generated first
+        glm::vec3 m_priority_direction = glm::vec3(0);  ///< The chunks ahead of it are generated first (none if zero)
+
+        /// The chunks are loaded/unloaded by the main thread but looked up by the generation jobs.
+        ShardedMap<glm::ivec3, std::shared_ptr<Chunk>, vec_hash> m_chunks;
 
-        std::unordered_map<glm::ivec3, std::shared_ptr<Chunk>, vec_hash> m_chunks;
+        ChunkMetrics m_chunk_metrics;
 
     public:
-        explicit World(VolumeGenerator &volume_generator, SurfaceGenerator &surface_generator);
+        explicit World(VolumeGenerator &volume_generator, SurfaceGenerator &surface_generator, ThreadPool &thread_pool);
         ~World();
 
-        bool is_chunk_loaded(glm::ivec3 const &chunk_pos) const { return m_chunks.contains(chunk_pos); }
-        size_t get_loaded_chunk_count() const { return m_chunks.size(); }
+        bool is_chunk_loaded(glm::ivec3 const &chunk_pos) const;
+        size_t get_loaded_chunk_count() const;
 
         /// Gets the chunk loaded at the given position. The returned chunk shares the ownership with the World, which means the
         /// requester could become the only owner of the chunk (e.g. in case the chunk is unloaded).
-        std::shared_ptr<Chunk> get_chunk(glm::ivec3 const &chunk_pos) { return m_chunks.at(chunk_pos); };
+        std::shared_ptr<Chunk> get_chunk(glm::ivec3 const &chunk_pos);
+
+        /// Same as get_chunk() but returns nullptr if the chunk isn't loaded.
+        std::shared_ptr<Chunk> find_chunk(glm::ivec3 const &chunk_pos) const;
+
+        /// Gets the loaded neighbours of the given chunk position (nullptr for the missing ones). Can be called from any thread, the
+        /// neighbours are kept alive by the returned array even if unloaded meanwhile.
+        ChunkNeighboursT get_chunk_neighbours(glm::ivec3 const &chunk_pos) const;
+
+        /// Copies the borders of the neighbours of the given chunk position, whose volume has been generated.
+        ChunkBorders get_chunk_borders(glm::ivec3 const &chunk_pos) const;
 
         VolumeGenerator &get_volume_generator() const { return m_volume_generator; }
         SurfaceGenerator &get_surface_generator() const { return m_surface_generator; }
 
+        ChunkMetrics &get_chunk_metrics() { return m_chunk_metrics; }
+        ChunkMetrics const &get_chunk_metrics() const { return m_chunk_metrics; }
+
+        VolumeStoragePolicy get_volume_storage_policy() const { return m_volume_storage_policy; }
+
+        /// Sets the storage policy for the chunks loaded from now on.
+        void set_volume_storage_policy(VolumeStoragePolicy policy) { m_volume_storage_policy = policy; }
+
+        /// Loads and generates the chunk asynchronously. The callback is called once the chunk is generated, then again every time its
+        /// surface is regenerated because a neighbour got generated (always from a worker thread).
         std::pair<Chunk &, bool> load_chunk_async(glm::ivec3 const &chunk_pos, ChunkLoadedCallbackT const &callback);
+
+        /// Unloads the chunk and cancels its generation: the queued jobs are dropped, the running ones stop at the next stage.
         bool unload_chunk(glm::ivec3 const &chunk_pos);
 
+        glm::ivec3 get_priority_center() const { return m_priority_center; }
+
+        /// Sets the chunk position whose surroundings should be generated first (e.g. the player's chunk), and reorders the generation
+        /// jobs already queued accordingly.
+        void set_priority_center(glm::ivec3 const &chunk_pos);
+
+        glm::vec3 get_priority_direction() const { return m_priority_direction; }
+
+        /// Sets the direction whose chunks should be generated first (e.g. the camera forward direction), a zero vector meaning none. The
+        /// generation jobs already queued are only reordered once the direction turned noticeably, not on every small rotation.
+        void set_priority_direction(glm::vec3 const &direction);
+
+        /// Returns the generation priority of the chunk (lowest first): the squared distance to the priority center, scaled down by up to
+        /// k_priority_direction_weight for the chunks ahead of the priority direction and up as much for the ones behind.
+        static float get_chunk_priority(glm::ivec3 const &priority_center, glm::vec3 const &priority_direction, glm::ivec3 const &chunk_pos);
+
+        static constexpr float k_priority_direction_weight = 0.5f;
+
     private:
-        void generate_chunk_surface(Chunk &chunk);
-        void generate_chunk_async(std::shared_ptr<Chunk> const &chunk, ChunkLoadedCallbackT const &callback);
+        /// Generates the surface of the chunk against the neighbours available at the moment. Meshes again rather than replacing a surface
+        /// generated concurrently against more neighbours.
+        /// \return The neighbours considered (a bit per BlockFace).
+        uint8_t generate_chunk_surface(Chunk &chunk);
+
+        /// Recomputes the priority of the loaded chunks and reorders the generation jobs already queued.
+        void update_chunk_priorities();
+
+        /// Returns the neighbours of the given chunk position whose volume has been generated (a bit per BlockFace).
+        uint8_t get_available_neighbour_mask(glm::ivec3 const &chunk_pos) const;
+
+        /// Regenerates the surface of the neighbours of the given chunk that were meshed without it, as their faces touching the chunk
+        /// could now be hidden.
+        void regenerate_neighbour_surfaces_async(Chunk const &chunk);
+        /// Generates the chunk, then calls its surface callback. Once the pools are warm, scheduling the generation doesn't allocate.
+        void generate_chunk_async(std::shared_ptr<Chunk> const &chunk);
     };
 }  // namespace explo
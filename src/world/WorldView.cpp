@@ -1,22 +1,24 @@
 #include "WorldView.hpp"
 
+#include <algorithm>
+
 #include "DeltaChunkIterator.hpp"
-#include "Game.hpp"
 #include "log.hpp"
-#include "util/JobChain.hpp"
 
 using namespace explo;
 
-#define CALL_RENDER_API
-
-#ifdef CALL_RENDER_API
-#include "video/RenderApi.hpp"
-#endif
-
-WorldView::WorldView(World &world, glm::ivec3 const &init_position, glm::ivec3 const &render_distance) :
+WorldView::WorldView(
+    World &world, RenderSink &render_sink, glm::ivec3 const &init_position, glm::ivec3 const &render_distance, glm::vec3 const &view_direction
+) :
     m_world(world),
-    m_render_distance(render_distance)
+    m_render_sink(render_sink),
+    m_render_distance(render_distance),
+    m_view_direction(view_direction)
 {
+    m_world.set_priority_direction(m_view_direction);
+
+    m_render_sink.world_view_recreate(init_position, render_distance);
+
     // Use an old position such that DeltaChunkIterator will iterate over all the chunks (as the world has changed)
     m_position = init_position + glm::ivec3(m_render_distance * 2 + 1);
     set_position(init_position);
@@ -52,6 +54,9 @@ void WorldView::offset_position(glm::ivec3 const &offset)
     glm::ivec3 old_position = m_position;
     m_position += offset;
 
+    // Generate the chunks around the new position first, including the ones already queued
+    m_world.set_priority_center(m_position);
+
     // Destroy the chunks that went out of the world view
     DeltaChunkIterator old_chunks_iterator(
         m_position,
@@ -60,52 +65,43 @@ void WorldView::offset_position(glm::ivec3 const &offset)
         [&](glm::ivec3 const &chunk_pos)
         {
             m_world.unload_chunk(chunk_pos);
-
-#ifdef CALL_RENDER_API
-            RenderApi::world_view_destroy_chunk(chunk_pos);
-#endif
+            m_render_sink.world_view_destroy_chunk(chunk_pos);
         }
     );
     old_chunks_iterator.iterate();
 
-#ifdef CALL_RENDER_API
     // Set the world view new position for the renderer, this has to be done *after* destroying old chunks. If the position were
     // set before destroying the chunks, old chunk references would go missing and leak memory
-    RenderApi::world_view_set_position(m_position);
-#endif
+    m_render_sink.world_view_set_position(m_position);
+
+    // Iterate the new chunks, and request them closest first: the first jobs are picked by the workers before the following ones are
+    // even enqueued (e.g. on spawn, the chunk under the player would be generated after the far corners of the world view otherwise)
+    m_chunks_to_load.clear();
 
-    // Iterate the new chunks, generate and upload them for rendering
     DeltaChunkIterator new_chunks_iterator(
         old_position,
         m_position,
         m_render_distance,
         [&](glm::ivec3 const &chunk_pos)
         {
-            glm::ivec3 rel_pos = chunk_pos - m_position + m_render_distance;
-
-            m_world.load_chunk_async(
-                chunk_pos,
-                [](std::shared_ptr<Chunk> const &chunk)
-                {
-#ifdef CALL_RENDER_API
-                    explo::run_on_main_thread(
-                        [weak_chunk = std::weak_ptr(chunk)]()
-                        {
-                            std::shared_ptr<Chunk> chunk = weak_chunk.lock();
-                            if (!chunk) return;
-
-                            // Try to upload the chunk for rendering. Since the generation is asynchronous, we could be asking the renderer
-                            // to upload a chunk that is now outside the world view (e.g. the player moved very fast). In this case the
-                            // renderer will silently ignore the uploading
-                            RenderApi::world_view_upload_chunk(*chunk);
-                        }
-                    );
-#endif
-                }
-            );
+            m_chunks_to_load.push_back(chunk_pos);
         }
     );
     new_chunks_iterator.iterate();
+
+    sort_by_load_order(m_chunks_to_load, m_position, m_view_direction);
+
+    // Generate and upload them for rendering (again every time their surface is regenerated)
+    for (glm::ivec3 const &chunk_pos : m_chunks_to_load)
+    {
+        m_world.load_chunk_async(
+            chunk_pos,
+            [&render_sink = m_render_sink](std::shared_ptr<Chunk> const &chunk)
+            {
+                render_sink.world_view_upload_chunk(chunk);
+            }
+        );
+    }
 }
 
 void WorldView::set_position(glm::ivec3 const &chunk_pos)
@@ -113,6 +109,12 @@ void WorldView::set_position(glm::ivec3 const &chunk_pos)
     offset_position(chunk_pos - m_position);
 }
 
+void WorldView::set_view_direction(glm::vec3 const &view_direction)
+{
+    m_view_direction = view_direction;
+    m_world.set_priority_direction(m_view_direction);
+}
+
 bool WorldView::is_chunk_position_inside(glm::ivec3 const &world_view_pos, glm::ivec3 const &render_distance, glm::ivec3 const &chunk_pos)
 {
     glm::ivec3 side = render_distance * 2 + 1;
@@ -135,3 +137,18 @@ void WorldView::iterate_chunks(glm::ivec3 const &position, glm::ivec3 const &ren
         }
     }
 }
+
+void WorldView::sort_by_load_order(std::vector<glm::ivec3> &chunk_positions, glm::ivec3 const &world_view_pos, glm::vec3 const &view_direction)
+{
+    glm::vec3 normalized_direction = glm::length(view_direction) > 0.0f ? glm::normalize(view_direction) : glm::vec3(0);
+
+    std::sort(
+        chunk_positions.begin(),
+        chunk_positions.end(),
+        [&](glm::ivec3 const &a, glm::ivec3 const &b)
+        {
+            return World::get_chunk_priority(world_view_pos, normalized_direction, a) <
+                   World::get_chunk_priority(world_view_pos, normalized_direction, b);
+        }
+    );
+}
@@ -2,11 +2,10 @@
 
 #include <glm/glm.hpp>
 #include <memory>
+#include <vector>
 
 #include "World.hpp"
-#include "util/CircularImage3d.hpp"
-#include "util/Image3d.hpp"
-#include "util/VirtualAllocator.hpp"
+#include "video/RenderSink.hpp"
 
 namespace explo
 {
@@ -20,11 +19,22 @@ namespace explo
 
     private:
         World &m_world;
+        RenderSink &m_render_sink;  ///< Must outlive the World and its generation jobs, the chunks upload to it
+
         glm::ivec3 m_position;
         glm::ivec3 m_render_distance;
+        glm::vec3 m_view_direction;
+
+        std::vector<glm::ivec3> m_chunks_to_load;  ///< Kept across the moves not to reallocate it
 
     public:
-        explicit WorldView(World &world, glm::ivec3 const &init_position, glm::ivec3 const &render_distance);
+        explicit WorldView(
+            World &world,
+            RenderSink &render_sink,
+            glm::ivec3 const &init_position,
+            glm::ivec3 const &render_distance,
+            glm::vec3 const &view_direction = glm::vec3(0)
+        );
         ~WorldView();
 
         glm::ivec3 get_render_distance() const { return m_render_distance; }
@@ -44,6 +54,11 @@ namespace explo
         void offset_position(glm::ivec3 const &offset);
         void set_position(glm::ivec3 const &chunk_pos);
 
+        glm::vec3 get_view_direction() const { return m_view_direction; }
+
+        /// Sets the direction the world view is looked from (e.g. the camera forward direction): the chunks ahead are generated first.
+        void set_view_direction(glm::vec3 const &view_direction);
+
         // ------------------------------------------------------------------------------------------------ Static methods
 
         static bool is_chunk_position_inside(glm::ivec3 const &world_view_pos, glm::ivec3 const &render_distance, glm::ivec3 const &chunk_pos);
@@ -52,6 +67,10 @@ namespace explo
         static void iterate_chunks(
             glm::ivec3 const &world_view_pos, glm::ivec3 const &render_distance, std::function<void(glm::ivec3 const &)> const &callback
         );
+
+        /// Sorts the chunk positions in load order: by increasing distance to the world view position (i.e. in shells around it), the
+        /// chunks ahead of the view direction first. This is the order of World::get_chunk_priority().
+        static void sort_by_load_order(std::vector<glm::ivec3> &chunk_positions, glm::ivec3 const &world_view_pos, glm::vec3 const &view_direction);
     };
 
 }  // namespace explo
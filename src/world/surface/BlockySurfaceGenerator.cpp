@@ -2,98 +2,95 @@
 
 #include <glm/glm.hpp>
 
-#include "Game.hpp"
 #include "world/Chunk.hpp"
 
 using namespace explo;
 
-void BlockySurfaceGenerator::write_block_geometry(Chunk &chunk, glm::ivec3 const &block, uint8_t block_type, SurfaceWriter &surface_writer)
+void BlockySurfaceGenerator::write_block_geometry(
+    Chunk &chunk, ChunkBorders const &borders, glm::ivec3 const &block, uint8_t block_type, SurfaceWriter &surface_writer
+)
 {
-    glm::vec2 texcoord = glm::vec2((float(block_type) + 0.5f) / float(game().m_block_registry.size()), 0.5f);
-
-    glm::vec3 f = chunk.to_world_position(block);                                        // Block from (world space)
-    glm::vec3 t = f + (glm::vec3(Chunk::k_world_size) / glm::vec3(Chunk::k_grid_size));  // Block to (world space)
+    glm::ivec3 f = block;                  // Block from (chunk space)
+    glm::ivec3 t = block + glm::ivec3(1);  // Block to (chunk space)
 
     // Left face
-    if (block.x == 0 || chunk.get_block_type_at(block + glm::ivec3(-1, 0, 0)) == 0)  // TODO check if the offset block is still inside the chunk
+    if (borders.get_block_type_at(chunk, block + glm::ivec3(-1, 0, 0)) == 0)
     {
         surface_writer.add_quad(
-            SurfaceVertex{.m_position = glm::vec3(f.x, f.y, t.z), .m_normal = glm::vec3(-1, 0, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(f.x, f.y, f.z), .m_normal = glm::vec3(-1, 0, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(f.x, t.y, f.z), .m_normal = glm::vec3(-1, 0, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(f.x, t.y, t.z), .m_normal = glm::vec3(-1, 0, 0), .m_texcoords = texcoord}
+            make_surface_vertex(glm::ivec3(f.x, f.y, t.z), BlockFace_Left, block_type),
+            make_surface_vertex(glm::ivec3(f.x, f.y, f.z), BlockFace_Left, block_type),
+            make_surface_vertex(glm::ivec3(f.x, t.y, f.z), BlockFace_Left, block_type),
+            make_surface_vertex(glm::ivec3(f.x, t.y, t.z), BlockFace_Left, block_type)
         );
     }
 
     // Right face
-    if (block.x == Chunk::k_grid_size.x - 1 || chunk.get_block_type_at(block + glm::ivec3(1, 0, 0)) == 0)
+    if (borders.get_block_type_at(chunk, block + glm::ivec3(1, 0, 0)) == 0)
     {
         surface_writer.add_quad(
-            SurfaceVertex{.m_position = glm::vec3(t.x, f.y, f.z), .m_normal = glm::vec3(-1, 0, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(t.x, f.y, t.z), .m_normal = glm::vec3(-1, 0, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(t.x, t.y, t.z), .m_normal = glm::vec3(-1, 0, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(t.x, t.y, f.z), .m_normal = glm::vec3(-1, 0, 0), .m_texcoords = texcoord}
+            make_surface_vertex(glm::ivec3(t.x, f.y, f.z), BlockFace_Right, block_type),
+            make_surface_vertex(glm::ivec3(t.x, f.y, t.z), BlockFace_Right, block_type),
+            make_surface_vertex(glm::ivec3(t.x, t.y, t.z), BlockFace_Right, block_type),
+            make_surface_vertex(glm::ivec3(t.x, t.y, f.z), BlockFace_Right, block_type)
         );
     }
 
     // Bottom face
-    if (block.z == 0 || chunk.get_block_type_at(block - glm::ivec3(0, 1, 0)) == 0)
+    if (borders.get_block_type_at(chunk, block + glm::ivec3(0, -1, 0)) == 0)
     {
         surface_writer.add_quad(
-            SurfaceVertex{.m_position = glm::vec3(f.x, f.y, f.z), .m_normal = glm::vec3(0, -1, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(f.x, f.y, t.z), .m_normal = glm::vec3(0, -1, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(t.x, f.y, t.z), .m_normal = glm::vec3(0, -1, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(t.x, f.y, f.z), .m_normal = glm::vec3(0, -1, 0), .m_texcoords = texcoord}
+            make_surface_vertex(glm::ivec3(f.x, f.y, f.z), BlockFace_Bottom, block_type),
+            make_surface_vertex(glm::ivec3(f.x, f.y, t.z), BlockFace_Bottom, block_type),
+            make_surface_vertex(glm::ivec3(t.x, f.y, t.z), BlockFace_Bottom, block_type),
+            make_surface_vertex(glm::ivec3(t.x, f.y, f.z), BlockFace_Bottom, block_type)
         );
     }
 
     // Top face
-    if (block.z == Chunk::k_grid_size.y - 1 || chunk.get_block_type_at(block + glm::ivec3(0, 1, 0)) == 0)
+    if (borders.get_block_type_at(chunk, block + glm::ivec3(0, 1, 0)) == 0)
     {
         surface_writer.add_quad(
-            SurfaceVertex{.m_position = glm::vec3(f.x, t.y, f.z), .m_normal = glm::vec3(0, 1, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(f.x, t.y, t.z), .m_normal = glm::vec3(0, 1, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(t.x, t.y, t.z), .m_normal = glm::vec3(0, 1, 0), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(t.x, t.y, f.z), .m_normal = glm::vec3(0, 1, 0), .m_texcoords = texcoord}
+            make_surface_vertex(glm::ivec3(f.x, t.y, f.z), BlockFace_Top, block_type),
+            make_surface_vertex(glm::ivec3(f.x, t.y, t.z), BlockFace_Top, block_type),
+            make_surface_vertex(glm::ivec3(t.x, t.y, t.z), BlockFace_Top, block_type),
+            make_surface_vertex(glm::ivec3(t.x, t.y, f.z), BlockFace_Top, block_type)
         );
     }
 
     // Back face
-    if (block.z == 0 || chunk.get_block_type_at(block + glm::ivec3(0, 0, -1)) == 0)
+    if (borders.get_block_type_at(chunk, block + glm::ivec3(0, 0, -1)) == 0)
     {
         surface_writer.add_quad(
-            SurfaceVertex{.m_position = glm::vec3(f.x, f.y, f.z), .m_normal = glm::vec3(0, 0, -1), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(f.x, t.y, f.z), .m_normal = glm::vec3(0, 0, -1), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(t.x, t.y, f.z), .m_normal = glm::vec3(0, 0, -1), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(t.x, f.y, f.z), .m_normal = glm::vec3(0, 0, -1), .m_texcoords = texcoord}
+            make_surface_vertex(glm::ivec3(f.x, f.y, f.z), BlockFace_Back, block_type),
+            make_surface_vertex(glm::ivec3(f.x, t.y, f.z), BlockFace_Back, block_type),
+            make_surface_vertex(glm::ivec3(t.x, t.y, f.z), BlockFace_Back, block_type),
+            make_surface_vertex(glm::ivec3(t.x, f.y, f.z), BlockFace_Back, block_type)
         );
     }
 
     // Front face
-    if (block.z == Chunk::k_grid_size.z - 1 || chunk.get_block_type_at(block + glm::ivec3(0, 0, 1)) == 0)
+    if (borders.get_block_type_at(chunk, block + glm::ivec3(0, 0, 1)) == 0)
     {
         surface_writer.add_quad(
-            SurfaceVertex{.m_position = glm::vec3(f.x, f.y, t.z), .m_normal = glm::vec3(0, 0, 1), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(f.x, t.y, t.z), .m_normal = glm::vec3(0, 0, 1), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(t.x, t.y, t.z), .m_normal = glm::vec3(0, 0, 1), .m_texcoords = texcoord},
-            SurfaceVertex{.m_position = glm::vec3(t.x, f.y, t.z), .m_normal = glm::vec3(0, 0, 1), .m_texcoords = texcoord}
+            make_surface_vertex(glm::ivec3(f.x, f.y, t.z), BlockFace_Front, block_type),
+            make_surface_vertex(glm::ivec3(f.x, t.y, t.z), BlockFace_Front, block_type),
+            make_surface_vertex(glm::ivec3(t.x, t.y, t.z), BlockFace_Front, block_type),
+            make_surface_vertex(glm::ivec3(t.x, f.y, t.z), BlockFace_Front, block_type)
         );
     }
 }
 
-void BlockySurfaceGenerator::generate(Chunk &chunk, SurfaceWriter &surface_writer)
+void BlockySurfaceGenerator::generate(Chunk &chunk, ChunkBorders const &borders, SurfaceWriter &surface_writer)
 {
-    chunk.octree().traverse(
-        [&](uint32_t block_type, uint32_t level, uint32_t morton_code)
+    chunk.for_each_block(
+        [&](glm::ivec3 const &block_pos, uint8_t block_type)
         {
-            if (block_type > 0)  // TODO check if it's a visible block or not using the BlockRegistry?
-            {
-                write_block_geometry(chunk, Octree::to_voxel_position(morton_code), block_type, surface_writer);
-            }
+            // TODO check if it's a visible block or not using the BlockRegistry?
+            write_block_geometry(chunk, borders, block_pos, block_type, surface_writer);
         }
     );
 
     surface_writer.add_instance(SurfaceInstance{
-        .m_transform = glm::identity<glm::mat4>(),
+        .m_transform = get_chunk_transform(chunk),
     });
 }
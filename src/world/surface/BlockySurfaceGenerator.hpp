@@ -13,9 +13,12 @@ namespace explo
         explicit BlockySurfaceGenerator() = default;
         ~BlockySurfaceGenerator() = default;
 
-        void generate(Chunk &chunk, SurfaceWriter &surface_writer) override;  // TODO no SurfaceWriter in function prototype
+        // TODO no SurfaceWriter in function prototype
+        void generate(Chunk &chunk, ChunkBorders const &borders, SurfaceWriter &surface_writer) override;
 
     protected:
-        void write_block_geometry(Chunk &chunk, glm::ivec3 const &block, uint8_t block_type, SurfaceWriter &surface_writer);
+        void write_block_geometry(
+            Chunk &chunk, ChunkBorders const &borders, glm::ivec3 const &block, uint8_t block_type, SurfaceWriter &surface_writer
+        );
     };
 }  // namespace explo
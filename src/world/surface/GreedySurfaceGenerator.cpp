@@ -0,0 +1,223 @@
+#include "GreedySurfaceGenerator.hpp"
+
+#include <algorithm>
+
+#include "world/Chunk.hpp"
+
+using namespace explo;
+
+namespace
+{
+    /// A copy of the chunk blocks surrounded by the borders of the neighbours, so that they can be read without bound checks. Also tracks the
+    /// box enclosing the non-empty blocks, so that the empty layers of the chunk (e.g. the sky) aren't scanned.
+    class PaddedVolume
+    {
+    private:
+        glm::ivec3 m_size;
+        std::vector<uint8_t> m_blocks;
+
+        glm::ivec3 m_min = Chunk::k_grid_size;
+        glm::ivec3 m_max = glm::ivec3(0);
+
+    public:
+        explicit PaddedVolume(Chunk const &chunk, ChunkBorders const &borders) :
+            m_size(Chunk::k_grid_size + 2)
+        {
+            m_blocks.resize(size_t(m_size.x) * m_size.y * m_size.z, 0);
+
+            for (uint32_t face = 0; face < BlockFace_Count; face++)
+            {
+                if (!borders.has_neighbour(BlockFace(face))) continue;
+
+                int d = face / 2;
+                int u = (d + 1) % 3;
+                int v = (d + 2) % 3;
+
+                glm::ivec3 block_pos{};
+                block_pos[d] = (face % 2) == 0 ? -1 : Chunk::k_grid_size[d];
+                for (block_pos[v] = 0; block_pos[v] < Chunk::k_grid_size[v]; block_pos[v]++)
+                {
+                    for (block_pos[u] = 0; block_pos[u] < Chunk::k_grid_size[u]; block_pos[u]++)
+                        m_blocks[to_index(block_pos)] = borders.get_block_type_at(block_pos);
+                }
+            }
+
+            chunk.for_each_block(
+                [&](glm::ivec3 const &block_pos, uint8_t block_type)
+                {
+                    m_blocks[to_index(block_pos)] = block_type;
+
+                    m_min = glm::min(m_min, block_pos);
+                    m_max = glm::max(m_max, block_pos + 1);
+                }
+            );
+        }
+
+        /// The box [min, max) enclosing the non-empty blocks (empty if the chunk is air only).
+        glm::ivec3 const &get_min() const { return m_min; }
+        glm::ivec3 const &get_max() const { return m_max; }
+
+        uint8_t get_block_type_at(glm::ivec3 const &block_pos) const { return m_blocks[to_index(block_pos)]; }
+
+    private:
+        size_t to_index(glm::ivec3 const &block_pos) const
+        {
+            return (size_t(block_pos.y + 1) * m_size.z + (block_pos.z + 1)) * m_size.x + (block_pos.x + 1);
+        }
+    };
+}  // namespace
+
+void GreedySurfaceGenerator::generate_quads(Chunk const &chunk, ChunkBorders const &borders, std::vector<Quad> &quads)
+{
+    PaddedVolume volume(chunk, borders);
+
+    glm::ivec3 min = volume.get_min();
+    glm::ivec3 max = volume.get_max();
+    if (min.x >= max.x) return;  // Air only
+
+    std::vector<uint8_t> mask;
+
+    for (uint32_t face = 0; face < BlockFace_Count; face++)
+    {
+        // The axis the face is orthogonal to (d), and the two axes spanning the face plane (u, v)
+        int d = face / 2;
+        int u = (d + 1) % 3;
+        int v = (d + 2) % 3;
+
+        glm::ivec3 normal(0);
+        normal[d] = (face % 2) == 0 ? -1 : 1;
+
+        int width_u = max[u] - min[u];
+        int width_v = max[v] - min[v];
+        mask.resize(size_t(width_u) * width_v);
+
+        for (int slice = min[d]; slice < max[d]; slice++)
+        {
+            // Build the mask of the visible faces of the slice, holding the block type of the face
+            glm::ivec3 block_pos{};
+            block_pos[d] = slice;
+            for (int j = 0; j < width_v; j++)
+            {
+                block_pos[v] = min[v] + j;
+                for (int i = 0; i < width_u; i++)
+                {
+                    block_pos[u] = min[u] + i;
+
+                    uint8_t block_type = volume.get_block_type_at(block_pos);
+                    bool visible = block_type != 0 && volume.get_block_type_at(block_pos + normal) == 0;
+                    mask[j * width_u + i] = visible ? block_type : 0;
+                }
+            }
+
+            // Greedily cover the mask with rectangles: extend along u first, then along v while the whole row matches
+            for (int j = 0; j < width_v; j++)
+            {
+                for (int i = 0; i < width_u;)
+                {
+                    uint8_t block_type = mask[j * width_u + i];
+                    if (block_type == 0)
+                    {
+                        i++;
+                        continue;
+                    }
+
+                    int width = 1;
+                    while (i + width < width_u && mask[j * width_u + i + width] == block_type) width++;
+
+                    int height = 1;
+                    for (; j + height < width_v; height++)
+                    {
+                        uint8_t const *row = &mask[(j + height) * width_u + i];
+                        if (std::any_of(row, row + width, [&](uint8_t other) { return other != block_type; })) break;
+                    }
+
+                    for (int h = 0; h < height; h++) std::fill_n(&mask[(j + h) * width_u + i], width, 0);
+
+                    Quad quad{.m_face = BlockFace(face), .m_from = glm::ivec3(0), .m_to = glm::ivec3(0), .m_block_type = block_type};
+                    quad.m_from[d] = slice;
+                    quad.m_from[u] = min[u] + i;
+                    quad.m_from[v] = min[v] + j;
+                    quad.m_to[d] = slice + 1;
+                    quad.m_to[u] = min[u] + i + width;
+                    quad.m_to[v] = min[v] + j + height;
+                    quads.push_back(quad);
+
+                    i += width;
+                }
+            }
+        }
+    }
+}
+
+void GreedySurfaceGenerator::write_quad_geometry(Chunk &chunk, Quad const &quad, SurfaceWriter &surface_writer)
+{
+    glm::ivec3 const &f = quad.m_from;  // Quad from (chunk space)
+    glm::ivec3 const &t = quad.m_to;    // Quad to (chunk space)
+
+    // Same vertex ordering of BlockySurfaceGenerator
+    switch (quad.m_face)
+    {
+        case BlockFace_Left:
+            surface_writer.add_quad(
+                make_surface_vertex(glm::ivec3(f.x, f.y, t.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(f.x, f.y, f.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(f.x, t.y, f.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(f.x, t.y, t.z), quad.m_face, quad.m_block_type)
+            );
+            break;
+        case BlockFace_Right:
+            surface_writer.add_quad(
+                make_surface_vertex(glm::ivec3(t.x, f.y, f.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(t.x, f.y, t.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(t.x, t.y, t.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(t.x, t.y, f.z), quad.m_face, quad.m_block_type)
+            );
+            break;
+        case BlockFace_Bottom:
+            surface_writer.add_quad(
+                make_surface_vertex(glm::ivec3(f.x, f.y, f.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(f.x, f.y, t.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(t.x, f.y, t.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(t.x, f.y, f.z), quad.m_face, quad.m_block_type)
+            );
+            break;
+        case BlockFace_Top:
+            surface_writer.add_quad(
+                make_surface_vertex(glm::ivec3(f.x, t.y, f.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(f.x, t.y, t.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(t.x, t.y, t.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(t.x, t.y, f.z), quad.m_face, quad.m_block_type)
+            );
+            break;
+        case BlockFace_Back:
+            surface_writer.add_quad(
+                make_surface_vertex(glm::ivec3(f.x, f.y, f.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(f.x, t.y, f.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(t.x, t.y, f.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(t.x, f.y, f.z), quad.m_face, quad.m_block_type)
+            );
+            break;
+        case BlockFace_Front:
+            surface_writer.add_quad(
+                make_surface_vertex(glm::ivec3(f.x, f.y, t.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(f.x, t.y, t.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(t.x, t.y, t.z), quad.m_face, quad.m_block_type),
+                make_surface_vertex(glm::ivec3(t.x, f.y, t.z), quad.m_face, quad.m_block_type)
+            );
+            break;
+        default:
+            break;
+    }
+}
+
+void GreedySurfaceGenerator::generate(Chunk &chunk, ChunkBorders const &borders, SurfaceWriter &surface_writer)
+{
+    std::vector<Quad> quads;
+    generate_quads(chunk, borders, quads);
+
+    for (Quad const &quad : quads) write_quad_geometry(chunk, quad, surface_writer);
+
+    surface_writer.add_instance(SurfaceInstance{
+        .m_transform = get_chunk_transform(chunk),
+    });
+}
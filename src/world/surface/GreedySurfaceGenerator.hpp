@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "SurfaceGenerator.hpp"
+
+namespace explo
+{
+    /// Merges the coplanar visible faces having the same block type into maximal rectangles (greedy meshing). Compared to
+    /// BlockySurfaceGenerator, that writes one quad per visible face, flat terrain is covered by a handful of quads.
+    class GreedySurfaceGenerator : public SurfaceGenerator
+    {
+    public:
+        /// A rectangle of merged faces. The box [m_from, m_to), relative to the chunk, is one block thick along the face axis.
+        struct Quad
+        {
+            BlockFace m_face;
+            glm::ivec3 m_from;
+            glm::ivec3 m_to;
+            uint8_t m_block_type;
+        };
+
+    public:
+        explicit GreedySurfaceGenerator() = default;
+        ~GreedySurfaceGenerator() = default;
+
+        void generate(Chunk &chunk, ChunkBorders const &borders, SurfaceWriter &surface_writer) override;
+
+        /// Computes the merged visible faces of the chunk (a face is visible if the block in front of it is air, blocks outside of the
+        /// chunk are read from the borders).
+        static void generate_quads(Chunk const &chunk, ChunkBorders const &borders, std::vector<Quad> &quads);
+
+    protected:
+        void write_quad_geometry(Chunk &chunk, Quad const &quad, SurfaceWriter &surface_writer);
+    };
+}  // namespace explo
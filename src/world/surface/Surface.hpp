@@ -1,15 +1,63 @@
 #pragma once
 
 #include <cstdint>
-#include <vren/gpu_repr.hpp>
+#include <glm/glm.hpp>
+#include <vector>
 
 namespace explo
 {
-    using SurfaceVertex = vren::vertex;
+    /// The faces of a block, the index is also the face id stored within SurfaceVertex.
+    enum BlockFace : uint8_t
+    {
+        BlockFace_Left = 0,  ///< -X
+        BlockFace_Right,     ///< +X
+        BlockFace_Bottom,    ///< -Y
+        BlockFace_Top,       ///< +Y
+        BlockFace_Back,      ///< -Z
+        BlockFace_Front,     ///< +Z
+
+        BlockFace_Count
+    };
+
+    /// A packed chunk vertex (8 bytes). The position is relative to the chunk, in blocks; vertices lie on block corners, hence range
+    /// from 0 to the chunk grid size (inclusive). The normal and the texture coordinates are derived, in the vertex shader, from the face
+    /// and the block type. Must match the vertex input of resources/shaders/draw_chunk.vert.
+    struct SurfaceVertex
+    {
+        uint8_t m_x;
+        uint8_t m_z;
+        uint16_t m_y;
+        uint8_t m_face;
+        uint8_t m_block_type;
+        uint16_t _pad;
+
+        glm::ivec3 get_position() const { return glm::ivec3(m_x, m_y, m_z); }
+    };
+
+    static_assert(sizeof(SurfaceVertex) == 8);
+
+    inline SurfaceVertex make_surface_vertex(glm::ivec3 const &position, BlockFace face, uint8_t block_type)
+    {
+        return SurfaceVertex{
+            .m_x = uint8_t(position.x),
+            .m_z = uint8_t(position.z),
+            .m_y = uint16_t(position.y),
+            .m_face = face,
+            .m_block_type = block_type,
+            ._pad = 0,
+        };
+    }
 
     using SurfaceIndex = uint32_t;
 
-    using SurfaceInstance = vren::mesh_instance;
+    /// The instance transform maps the chunk-relative vertex positions to world space. Must match the instance input of
+    /// resources/shaders/draw_chunk.vert.
+    struct SurfaceInstance
+    {
+        glm::mat4 m_transform;
+    };
+
+    static_assert(sizeof(SurfaceInstance) == sizeof(glm::mat4));
 
     struct Surface
     {
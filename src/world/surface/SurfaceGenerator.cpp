@@ -0,0 +1,15 @@
+#include "SurfaceGenerator.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "world/Chunk.hpp"
+
+using namespace explo;
+
+glm::mat4 SurfaceGenerator::get_chunk_transform(Chunk const &chunk)
+{
+    glm::vec3 block_size = Chunk::k_world_size / glm::vec3(Chunk::k_grid_size);
+
+    glm::mat4 transform = glm::translate(glm::identity<glm::mat4>(), chunk.to_world_position(glm::vec3(0)));
+    return glm::scale(transform, block_size);
+}
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <glm/glm.hpp>
+
 #include "SurfaceWriter.hpp"
+#include "world/ChunkBorders.hpp"
 
 namespace explo
 {
@@ -10,6 +13,12 @@ namespace explo
     class SurfaceGenerator
     {
     public:
-        virtual void generate(Chunk &chunk, SurfaceWriter &surface_writer) = 0;
+        /// Generates the surface of the chunk. The borders hold the blocks of the neighbouring chunks, so that the faces on the chunk
+        /// border hidden by a neighbour can be skipped.
+        virtual void generate(Chunk &chunk, ChunkBorders const &borders, SurfaceWriter &surface_writer) = 0;
+
+    protected:
+        /// The instance transform that maps the surface vertices (relative to the chunk, in blocks) to world space.
+        static glm::mat4 get_chunk_transform(Chunk const &chunk);
     };
 }  // namespace explo
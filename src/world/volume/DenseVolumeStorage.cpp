@@ -0,0 +1,23 @@
+#include "DenseVolumeStorage.hpp"
+
+#include <algorithm>
+
+using namespace explo;
+
+DenseVolumeStorage::DenseVolumeStorage(glm::ivec3 const &size) :
+    m_size(size)
+{
+    m_blocks.resize(size_t(m_size.x) * m_size.y * m_size.z);  // Zero means air
+}
+
+void DenseVolumeStorage::fill_block_type(glm::ivec3 const &from, glm::ivec3 const &to, uint8_t block_type)
+{
+    for (int y = from.y; y < to.y; y++)
+    {
+        for (int z = from.z; z < to.z; z++)
+        {
+            auto row = m_blocks.begin() + to_index(glm::ivec3(from.x, y, z));
+            std::fill(row, row + (to.x - from.x), block_type);
+        }
+    }
+}
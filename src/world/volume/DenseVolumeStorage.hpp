@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+
+#include "VolumeStorage.hpp"
+
+namespace explo
+{
+    /// Stores one byte per block, X-major then Z then Y (i.e. a vertical run of blocks is strided by a whole XZ slice).
+    class DenseVolumeStorage : public VolumeStorage
+    {
+    private:
+        glm::ivec3 m_size;
+        std::vector<uint8_t> m_blocks;
+
+    public:
+        explicit DenseVolumeStorage(glm::ivec3 const &size);
+        ~DenseVolumeStorage() override = default;
+
+        VolumeStorageType get_type() const override { return VolumeStorageType::Dense; }
+
+        glm::ivec3 const &get_size() const { return m_size; }
+        uint8_t const *data() const { return m_blocks.data(); }
+
+        uint8_t get_block_type_at(glm::ivec3 const &block_pos) const override { return m_blocks[to_index(block_pos)]; }
+        void set_block_type_at(glm::ivec3 const &block_pos, uint8_t block_type) override { m_blocks[to_index(block_pos)] = block_type; }
+
+        void fill_block_type(glm::ivec3 const &from, glm::ivec3 const &to, uint8_t block_type) override;
+
+        size_t get_byte_size() const override { return m_blocks.size(); }
+
+        /// Calls the visitor, taking the block position and the block type, for every non-empty block.
+        template <typename _VisitorT>
+        void for_each_block(_VisitorT &&visitor) const
+        {
+            size_t i = 0;
+            glm::ivec3 block_pos{};
+            for (block_pos.y = 0; block_pos.y < m_size.y; block_pos.y++)
+            {
+                for (block_pos.z = 0; block_pos.z < m_size.z; block_pos.z++)
+                {
+                    for (block_pos.x = 0; block_pos.x < m_size.x; block_pos.x++, i++)
+                    {
+                        if (m_blocks[i] != 0) visitor(block_pos, m_blocks[i]);
+                    }
+                }
+            }
+        }
+
+    private:
+        size_t to_index(glm::ivec3 const &block_pos) const { return (size_t(block_pos.y) * m_size.z + block_pos.z) * m_size.x + block_pos.x; }
+    };
+}  // namespace explo
@@ -1,16 +1,252 @@
 #include "Octree.hpp"
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define EXPLO_MORTON_BMI2
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define EXPLO_TARGET_BMI2
+#else
+#include <cpuid.h>
+#define EXPLO_TARGET_BMI2 __attribute__((target("bmi2")))
+#endif
+#endif
+
 using namespace explo;
 
-Octree::Octree(uint32_t depth) :
-    m_depth(depth)
+// ------------------------------------------------------------------------------------------------
+// Morton code
+// ------------------------------------------------------------------------------------------------
+
+// Every axis takes 10 bits, the morton code takes 30 bits: bit 3*i is the i-th bit of X, bit 3*i+1 of Y, bit 3*i+2 of Z
+
+namespace
 {
+    /// Spreads the lowest 10 bits of the given number such that two zero bits are placed between each of them.
+    inline uint32_t spread_bits(uint32_t v)
+    {
+        v &= 0x000003FF;
+        v = (v | (v << 16)) & 0x030000FF;
+        v = (v | (v << 8)) & 0x0300F00F;
+        v = (v | (v << 4)) & 0x030C30C3;
+        v = (v | (v << 2)) & 0x09249249;
+        return v;
+    }
+
+    /// The inverse of spread_bits: takes every third bit (starting from the lowest one) and packs them together.
+    inline uint32_t compact_bits(uint32_t v)
+    {
+        v &= 0x09249249;
+        v = (v ^ (v >> 2)) & 0x030C30C3;
+        v = (v ^ (v >> 4)) & 0x0300F00F;
+        v = (v ^ (v >> 8)) & 0x030000FF;
+        v = (v ^ (v >> 16)) & 0x000003FF;
+        return v;
+    }
+
+#ifdef EXPLO_MORTON_BMI2
+    constexpr uint32_t k_morton_x_mask = 0x09249249;
+    constexpr uint32_t k_morton_y_mask = k_morton_x_mask << 1;
+    constexpr uint32_t k_morton_z_mask = k_morton_x_mask << 2;
+
+    EXPLO_TARGET_BMI2 uint32_t encode_morton_bmi2(uint32_t x, uint32_t y, uint32_t z)
+    {
+        return _pdep_u32(x, k_morton_x_mask) | _pdep_u32(y, k_morton_y_mask) | _pdep_u32(z, k_morton_z_mask);
+    }
+
+    EXPLO_TARGET_BMI2 glm::ivec3 decode_morton_bmi2(uint32_t morton_code)
+    {
+        return glm::ivec3(_pext_u32(morton_code, k_morton_x_mask), _pext_u32(morton_code, k_morton_y_mask), _pext_u32(morton_code, k_morton_z_mask));
+    }
+
+    /// Checks whether the CPU supports BMI2 and it's worth using it: AMD CPUs before Zen 3 implement pdep/pext in microcode, and they're
+    /// way slower than bit spreading.
+    bool should_use_bmi2()
+    {
+        uint32_t regs[4]{};  // EAX, EBX, ECX, EDX
+
+        auto cpuid = [&](uint32_t leaf)
+        {
+#ifdef _MSC_VER
+            __cpuidex(reinterpret_cast<int *>(regs), leaf, 0);
+#else
+            __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+        };
+
+        cpuid(0);
+        uint32_t max_leaf = regs[0];
+        bool is_amd = regs[1] == 0x68747541 /* "Auth" */ && regs[3] == 0x69746E65 /* "enti" */ && regs[2] == 0x444D4163 /* "cAMD" */;
+
+        if (max_leaf < 7) return false;
+
+        cpuid(1);
+        uint32_t family = (regs[0] >> 8) & 0xF;
+        if (family == 0xF) family += (regs[0] >> 20) & 0xFF;
+
+        cpuid(7);
+        bool has_bmi2 = (regs[1] & (1 << 8)) != 0;
+
+        return has_bmi2 && (!is_amd || family >= 0x19);
+    }
+
+    bool const s_use_bmi2 = should_use_bmi2();
+#endif
+}  // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Octree
+// ------------------------------------------------------------------------------------------------
+
+Octree::Octree(uint32_t depth, Layout layout, uint32_t prefix_levels) :
+    m_depth(depth),
+    m_layout(layout)
+{
+    if (m_layout == Layout::Packed)
+    {
+        // The last level can't be split (its nodes are voxels)
+        m_prefix_levels = glm::min(prefix_levels, m_depth - 1);
+        m_next_alloc_index = get_prefix_level_offset(m_prefix_levels + 1);
+
+        m_data.resize(m_next_alloc_index);  // Will zero the prefix
+
+        // Split every node of the prefix levels, the children of the i-th node of a level are the i-th group of the next level
+        for (uint32_t level = 0; level < m_prefix_levels; level++)
+        {
+            uint32_t level_offset = get_prefix_level_offset(level);
+            uint32_t next_level_offset = get_prefix_level_offset(level + 1);
+
+            for (uint32_t i = 0; i < next_level_offset - level_offset; i++) m_data[level_offset + i] = (next_level_offset + i * 8) | 0x80000000;
+        }
+    }
 }
 
 Octree::~Octree() {}
 
+uint32_t Octree::get_prefix_level_offset(uint32_t level)
+{
+    // 8 + 8^2 + ... + 8^level
+    return ((1u << (level * 3)) - 1) / 7 * 8;
+}
+
+uint32_t Octree::get_prefix_node_index(uint32_t morton_code) const
+{
+    return get_prefix_level_offset(m_prefix_levels) + ((morton_code >> ((m_depth - m_prefix_levels) * 3)) << 3);
+}
+
+uint32_t Octree::allocate_children()
+{
+    // Reuse the groups released by merging first
+    if (!m_free_groups.empty())
+    {
+        uint32_t children_idx = m_free_groups.back();
+        m_free_groups.pop_back();
+        return children_idx;
+    }
+
+    uint32_t children_idx = m_next_alloc_index;
+    m_next_alloc_index += 8;
+
+    // Ensure every referenced group lies within the storage (so that Packed reads never need bounds checking); the Linear layout
+    // grows by a fixed amount, the Packed layout grows geometrically
+    if (m_next_alloc_index > m_data.size())
+    {
+        size_t new_size = m_layout == Layout::Packed ? m_data.size() * 2 : m_data.size() + k_grow_size;
+        m_data.resize(glm::max<size_t>(new_size, m_next_alloc_index));  // Will keep current data and zero new data
+    }
+
+    return children_idx;
+}
+
+void Octree::free_children(uint32_t children_idx)
+{
+    m_free_groups.push_back(children_idx);
+}
+
+void Octree::release_children(uint32_t children_idx)
+{
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        uint32_t child_val = m_data[children_idx + i];
+        if ((child_val & 0x80000000) != 0) release_children(child_val & 0x7FFFFFFF);
+    }
+    free_children(children_idx);
+}
+
+bool Octree::is_uniform_group(uint32_t children_idx) const
+{
+    uint32_t value = m_data[children_idx];
+    if ((value & 0x80000000) != 0) return false;  // Parent nodes can't be merged
+
+    for (uint32_t i = 1; i < 8; i++)
+    {
+        if (m_data[children_idx + i] != value) return false;
+    }
+    return true;
+}
+
+uint32_t Octree::compact_node(StorageT &data, uint32_t node_val) const
+{
+    if ((node_val & 0x80000000) == 0) return node_val;  // Leaf node
+
+    uint32_t src_children_idx = node_val & 0x7FFFFFFF;
+
+    // Compact the children first (their groups are placed before the parent's one), if they end up being leaves with the same
+    // value the whole subtree is collapsed into a leaf
+    uint32_t children[8];
+    bool uniform = true;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        uint32_t child_val = (src_children_idx + i) < m_data.size() ? m_data[src_children_idx + i] : 0;
+        children[i] = compact_node(data, child_val);
+        uniform &= (children[i] & 0x80000000) == 0 && children[i] == children[0];
+    }
+
+    if (uniform) return children[0];
+
+    uint32_t children_idx = data.size();
+    data.insert(data.end(), children, children + 8);
+    return children_idx | 0x80000000;
+}
+
+void Octree::compact()
+{
+    if (m_data.empty()) return;
+
+    // Rebuild the storage from scratch, only the reachable and non-uniform groups are kept. The groups on top of the tree (the root for
+    // the Linear layout, the whole prefix for the Packed layout) are kept where they are
+    uint32_t top_offset = m_layout == Layout::Packed ? get_prefix_level_offset(m_prefix_levels) : 0;
+    uint32_t top_end = m_layout == Layout::Packed ? get_prefix_level_offset(m_prefix_levels + 1) : 8;
+
+    StorageT data(m_data.begin(), m_data.begin() + top_end);
+    for (uint32_t node_idx = top_offset; node_idx < top_end; node_idx++) data[node_idx] = compact_node(data, m_data[node_idx]);
+
+    data.shrink_to_fit();
+
+    m_data = std::move(data);
+    m_next_alloc_index = m_data.size();
+    m_free_groups.clear();
+}
+
 uint32_t Octree::get_voxel_at(uint32_t morton_code) const
 {
+    if (m_layout == Layout::Packed)
+    {
+        uint32_t node_idx = get_prefix_node_index(morton_code);
+        for (uint32_t level = m_prefix_levels; level < m_depth; level++)
+        {
+            uint32_t child_idx = (morton_code >> ((m_depth - level - 1) * 3)) & 0x7;
+
+            uint32_t child_val = m_data[node_idx + child_idx];
+            if ((child_val & 0x80000000) == 0) return child_val;  // Leaf node
+
+            node_idx = child_val & 0x7FFFFFFF;
+        }
+        return 0;
+    }
+
     uint32_t node_idx = 0;  // Root
     for (int level = 0; level < m_depth; level++)
     {
@@ -26,13 +262,26 @@ uint32_t Octree::get_voxel_at(uint32_t morton_code) const
     return 0;
 }
 
-void Octree::set_voxel_at(uint32_t morton_code, uint32_t value)
+void Octree::set_voxel_at(uint32_t morton_code, uint32_t value, bool merge)
 {
+    uint32_t group_path[32];  // The children group visited at every level, used to merge them back
+
     uint32_t node_idx = 0;
-    for (int level = 0; level < m_depth; level++)
+    uint32_t level = 0;
+
+    if (m_layout == Layout::Packed)
     {
+        node_idx = get_prefix_node_index(morton_code);
+        level = m_prefix_levels;
+    }
+
+    for (; level < m_depth; level++)
+    {
+        group_path[level] = node_idx;
+
         uint32_t child_idx = (morton_code >> ((m_depth - level - 1) * 3)) & 0x7;
-        if ((node_idx + child_idx) >= m_data.size()) m_data.resize(m_data.size() + k_grow_size);  // Will keep current data and zero new data
+        if (m_layout == Layout::Linear && (node_idx + child_idx) >= m_data.size())
+            m_data.resize(m_data.size() + k_grow_size);  // Will keep current data and zero new data
 
         uint32_t child_val = m_data[node_idx + child_idx];
         if ((child_val & 0x80000000) != 0)  // Parent node
@@ -48,74 +297,123 @@ void Octree::set_voxel_at(uint32_t morton_code, uint32_t value)
             else if (level == m_depth - 1)
             {  // I've reached the max resolution, I can just set the leaf node value and return
                 m_data[node_idx + child_idx] = value;
+                break;
             }
             else
-            {  // The leaf node becomes a parent node, and we allocate its children
-                m_data[node_idx + child_idx] = m_next_alloc_index | 0x80000000;
-                node_idx = m_next_alloc_index;
-                m_next_alloc_index += 8;
+            {  // The leaf node becomes a parent node, and we allocate its children (inheriting its value as it may have been merged)
+                uint32_t children_idx = allocate_children();
+                for (uint32_t i = 0; i < 8; i++) m_data[children_idx + i] = child_val;
+
+                m_data[node_idx + child_idx] = children_idx | 0x80000000;
+                node_idx = children_idx;
             }
         }
     }
-}
 
-void Octree::traverse_r(uint32_t node_idx, uint32_t level, uint32_t morton_code, TraversalCallbackT const &callback) const
-{
-    for (int child_idx = 0; child_idx < 8; child_idx++)
+    if (!merge) return;
+
+    // Walk back up to the root merging the groups that became uniform. Groups whose parent lies in the prefix can't be merged
+    uint32_t min_level = m_layout == Layout::Packed ? m_prefix_levels : 0;
+    for (; level > min_level; level--)
     {
-        if ((node_idx + child_idx) >= m_data.size()) return;
+        uint32_t group_idx = group_path[level];
+        if (!is_uniform_group(group_idx)) break;
 
-        uint32_t child_morton_code = morton_code | (child_idx << ((m_depth - level - 1) * 3));
-        uint32_t child_val = m_data[node_idx + child_idx];
-        if ((child_val & 0x80000000) != 0)  // Parent node
-        {
-            traverse_r(child_val & 0x7FFFFFFF, level + 1, child_morton_code, callback);
-        }
-        else if (child_val > 0)  // Leaf node
-        {
-            callback(child_val, level, child_morton_code);
-        }
+        uint32_t parent_child_idx = (morton_code >> ((m_depth - level) * 3)) & 0x7;
+        m_data[group_path[level - 1] + parent_child_idx] = m_data[group_idx];
+
+        free_children(group_idx);
     }
 }
 
-void Octree::traverse(TraversalCallbackT const &callback) const
+void Octree::fill_voxels_r(
+    uint32_t node_idx, uint32_t level, glm::ivec3 const &origin, glm::ivec3 const &from, glm::ivec3 const &to, uint32_t value
+)
 {
-    traverse_r(0, 0, 0, callback);
-}
+    int side = 1 << (m_depth - level - 1);
+    glm::ivec3 node_to = origin + side;
 
-uint32_t Octree::to_morton_code(glm::ivec3 const &voxel_pos)
-{
-    uint32_t x = voxel_pos.x;
-    uint32_t y = voxel_pos.y;
-    uint32_t z = voxel_pos.z;
+    // The node is outside of the box
+    if (node_to.x <= from.x || node_to.y <= from.y || node_to.z <= from.z || origin.x >= to.x || origin.y >= to.y || origin.z >= to.z) return;
+
+    bool is_prefix = level < m_prefix_levels;  // Prefix nodes must stay split (m_prefix_levels is 0 for the Linear layout)
+    uint32_t node_val = m_data[node_idx];
+
+    // The node is entirely covered by the box: we write it as a whole
+    bool covered = origin.x >= from.x && origin.y >= from.y && origin.z >= from.z && node_to.x <= to.x && node_to.y <= to.y && node_to.z <= to.z;
+    if (covered && !is_prefix)
+    {
+        if ((node_val & 0x80000000) != 0) release_children(node_val & 0x7FFFFFFF);
+
+        m_data[node_idx] = value;
+        return;
+    }
 
-    uint32_t morton_code = 0;
-    int i = 0;
-    while (x || y || z)
+    if ((node_val & 0x80000000) == 0)  // Leaf node, partially covered (hence it isn't at the last level)
     {
-        morton_code |= ((x & 1) | ((y & 1) << 1) | ((z & 1) << 2)) << (i * 3);
+        if (node_val == value) return;
+
+        uint32_t children_idx = allocate_children();
+        for (uint32_t i = 0; i < 8; i++) m_data[children_idx + i] = node_val;
 
-        x >>= 1;
-        y >>= 1;
-        z >>= 1;
+        m_data[node_idx] = children_idx | 0x80000000;
+    }
 
-        i++;
+    uint32_t children_idx = m_data[node_idx] & 0x7FFFFFFF;
+    int child_side = side >> 1;
+
+    for (uint32_t child_idx = 0; child_idx < 8; child_idx++)
+    {
+        glm::ivec3 child_origin = origin + glm::ivec3(child_idx & 1, (child_idx >> 1) & 1, (child_idx >> 2) & 1) * child_side;
+        fill_voxels_r(children_idx + child_idx, level + 1, child_origin, from, to, value);
+    }
+
+    if (!is_prefix && is_uniform_group(children_idx))
+    {
+        m_data[node_idx] = m_data[children_idx];
+        free_children(children_idx);
     }
-    return morton_code;
 }
 
-glm::ivec3 Octree::to_voxel_position(uint32_t morton_code)
+void Octree::fill_voxels(glm::ivec3 const &from, glm::ivec3 const &to, uint32_t value)
 {
-    glm::ivec3 voxel_pos{};
-    int i = 0;
-    while (morton_code > 0)
-    {
-        voxel_pos.x |= (morton_code & 1) << i;
-        voxel_pos.y |= ((morton_code & 0b10) >> 1) << i;
-        voxel_pos.z |= ((morton_code & 0b100) >> 2) << i;
+    glm::ivec3 clamped_from = glm::max(from, glm::ivec3(0));
+    glm::ivec3 clamped_to = glm::min(to, glm::ivec3(1 << m_depth));
+
+    if (clamped_from.x >= clamped_to.x || clamped_from.y >= clamped_to.y || clamped_from.z >= clamped_to.z) return;
+
+    if (m_data.size() < 8) m_data.resize(k_grow_size);  // The Linear layout lazily allocates the root
 
-        morton_code >>= 3;
-        i++;
+    int side = 1 << (m_depth - 1);
+    for (uint32_t child_idx = 0; child_idx < 8; child_idx++)
+    {
+        glm::ivec3 origin = glm::ivec3(child_idx & 1, (child_idx >> 1) & 1, (child_idx >> 2) & 1) * side;
+        fill_voxels_r(child_idx, 0, origin, clamped_from, clamped_to, value);
     }
-    return voxel_pos;
+}
+
+void Octree::traverse(TraversalCallbackT const &callback) const
+{
+    for_each_leaf(
+        [&](Leaf const &leaf)
+        {
+            callback(leaf.m_value, leaf.m_level, leaf.m_morton_code);
+        }
+    );
+}
+
+uint32_t Octree::to_morton_code(glm::ivec3 const &voxel_pos)
+{
+#ifdef EXPLO_MORTON_BMI2
+    if (s_use_bmi2) return encode_morton_bmi2(voxel_pos.x, voxel_pos.y, voxel_pos.z);
+#endif
+    return spread_bits(voxel_pos.x) | (spread_bits(voxel_pos.y) << 1) | (spread_bits(voxel_pos.z) << 2);
+}
+
+glm::ivec3 Octree::to_voxel_position(uint32_t morton_code)
+{
+#ifdef EXPLO_MORTON_BMI2
+    if (s_use_bmi2) return decode_morton_bmi2(morton_code);
+#endif
+    return glm::ivec3(compact_bits(morton_code), compact_bits(morton_code >> 1), compact_bits(morton_code >> 2));
 }
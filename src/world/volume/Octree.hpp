@@ -2,39 +2,231 @@
 
 #include <functional>
 #include <glm/glm.hpp>
+#include <iterator>
 #include <vector>
 
+#include "util/AlignedAllocator.hpp"
+
 namespace explo
 {
     class Octree
     {
+    public:
+        /// How the nodes are laid out within the octree storage.
+        enum class Layout
+        {
+            /// Children groups are appended as they're allocated and the storage grows by k_grow_size words.
+            Linear,
+
+            /// Children groups lie on 32-byte boundaries (two per cache line), the top levels are fully split and stored as a
+            /// breadth-first prefix (so they can be skipped with pure arithmetic) and the storage grows geometrically.
+            Packed
+        };
+
+        /// A non-empty leaf. A leaf at level L covers a cube of 2^(depth - L - 1) voxels per side.
+        struct Leaf
+        {
+            uint32_t m_value;
+            uint32_t m_level;
+            uint32_t m_morton_code;
+            glm::ivec3 m_position;  ///< The position of the first voxel covered by the leaf
+        };
+
+        class LeafIterator;
+        class LeafRange;
+
+        static constexpr uint32_t k_max_depth = 10;  // Bound by the morton code bits
         static constexpr size_t k_grow_size = 1024;
+        static constexpr size_t k_storage_alignment = 64;  // Cache line
+        static constexpr uint32_t k_default_prefix_levels = 2;
 
+    private:
         using TraversalCallbackT = std::function<void(uint32_t value, uint32_t level, uint32_t morton_code)>;
+        using StorageT = std::vector<uint32_t, AlignedAllocator<uint32_t, k_storage_alignment>>;
 
-    private:
-        std::vector<uint32_t> m_data;
+        StorageT m_data;
         uint32_t m_depth;
+        Layout m_layout;
+        uint32_t m_prefix_levels = 0;  ///< The number of levels that are always split (only meaningful for the Packed layout)
         uint32_t m_next_alloc_index = 8;
 
+        /// The children groups released by merging, reused before growing the storage.
+        std::vector<uint32_t> m_free_groups;
+
     public:
-        explicit Octree(uint32_t depth);
+        explicit Octree(uint32_t depth, Layout layout = Layout::Linear, uint32_t prefix_levels = k_default_prefix_levels);
         ~Octree();
 
         void const *data() const { return m_data.data(); }
         size_t size() const { return m_data.size(); }
 
+        uint32_t get_depth() const { return m_depth; }
+        Layout get_layout() const { return m_layout; }
+
         uint32_t get_voxel_at(uint32_t morton_code) const;
-        void set_voxel_at(uint32_t morton_code, uint32_t value);
 
-        // TODO Add a function to compact the octree: group 2x2x2 nodes with identical value into one
+        /// Sets the value of the voxel at the given morton code.
+        /// \param merge If set, the groups along the written path that become uniform are merged into their parent (incremental compaction).
+        void set_voxel_at(uint32_t morton_code, uint32_t value, bool merge = false);
+
+        /// Sets the value of every voxel within the box [from, to) (clamped to the octree). Nodes entirely covered by the box are
+        /// written as a whole (their subtree is released), and the groups that become uniform are merged.
+        void fill_voxels(glm::ivec3 const &from, glm::ivec3 const &to, uint32_t value);
+
+        /// Collapses every 2x2x2 group of leaves having the same value into one leaf (recursively), and rebuilds the storage so that
+        /// the freed groups are given back.
+        void compact();
+
+        /// Iterates the non-empty leaves in morton order, without recursion.
+        LeafRange leaves() const;
+
+        /// Calls the visitor, taking an Octree::Leaf, for every non-empty leaf. Prefer it over traverse() on hot paths as the visitor
+        /// is inlined.
+        template <typename _VisitorT>
+        void for_each_leaf(_VisitorT &&visitor) const;
 
+        /// Calls the callback for every non-empty leaf. A leaf at level L covers a cube of 2^(depth - L - 1) voxels per side.
         void traverse(TraversalCallbackT const &callback) const;
 
+        /// Interleaves the bits of the voxel position (10 bits per axis, hence up to a depth of 10). Uses BMI2 when the CPU has a fast
+        /// implementation of it, bit spreading otherwise.
         static uint32_t to_morton_code(glm::ivec3 const &voxel_pos);
         static glm::ivec3 to_voxel_position(uint32_t morton_code);
 
     private:
-        void traverse_r(uint32_t node_idx, uint32_t depth, uint32_t morton_code, TraversalCallbackT const &callback) const;
+        /// Returns the index of the first node of the given level within the breadth-first prefix.
+        static uint32_t get_prefix_level_offset(uint32_t level);
+
+        /// Returns the index of the children group, at the first level below the prefix, that contains the given morton code.
+        uint32_t get_prefix_node_index(uint32_t morton_code) const;
+
+        /// Allocates a group of 8 children and returns the index of the first one.
+        uint32_t allocate_children();
+        void free_children(uint32_t children_idx);
+
+        /// Gives back the given children group and all of its descendants.
+        void release_children(uint32_t children_idx);
+
+        void fill_voxels_r(
+            uint32_t node_idx, uint32_t level, glm::ivec3 const &origin, glm::ivec3 const &from, glm::ivec3 const &to, uint32_t value
+        );
+
+        /// Checks whether the given children group is made of leaves with the same value.
+        bool is_uniform_group(uint32_t children_idx) const;
+
+        /// Copies the subtree referenced by the given node value into the destination storage, collapsing the uniform groups.
+        /// \return The node value within the destination storage.
+        uint32_t compact_node(StorageT &data, uint32_t node_val) const;
     };
+
+    // ------------------------------------------------------------------------------------------------
+    // Octree::LeafIterator
+    // ------------------------------------------------------------------------------------------------
+
+    /// Walks the octree depth-first using an explicit stack; the position of the leaves is computed along the way (no morton decoding).
+    class Octree::LeafIterator
+    {
+    private:
+        struct Frame
+        {
+            uint32_t m_children_idx;
+            uint32_t m_next_child;
+            uint32_t m_morton_code;
+            glm::ivec3 m_origin;
+        };
+
+        Octree const *m_octree;
+
+        Frame m_stack[k_max_depth];
+        int m_top = -1;  ///< The level of the frame on top of the stack, -1 when the iteration is over
+
+        Leaf m_leaf{};
+
+    public:
+        explicit LeafIterator(Octree const &octree) :
+            m_octree(&octree)
+        {
+            if (m_octree->m_data.empty()) return;
+
+            m_stack[0] = Frame{.m_children_idx = 0, .m_next_child = 0, .m_morton_code = 0, .m_origin = glm::ivec3(0)};
+            m_top = 0;
+
+            advance();
+        }
+
+        Leaf const &operator*() const { return m_leaf; }
+        Leaf const *operator->() const { return &m_leaf; }
+
+        LeafIterator &operator++()
+        {
+            advance();
+            return *this;
+        }
+
+        bool operator==(std::default_sentinel_t) const { return m_top < 0; }
+
+    private:
+        void advance()
+        {
+            auto const &data = m_octree->m_data;
+            uint32_t depth = m_octree->m_depth;
+
+            while (m_top >= 0)
+            {
+                Frame &frame = m_stack[m_top];
+
+                uint32_t child_idx = frame.m_next_child++;
+                uint32_t node_idx = frame.m_children_idx + child_idx;
+                if (child_idx >= 8 || node_idx >= data.size())
+                {
+                    m_top--;
+                    continue;
+                }
+
+                uint32_t level = m_top;
+                uint32_t shift = depth - level - 1;
+
+                uint32_t morton_code = frame.m_morton_code | (child_idx << (shift * 3));
+                glm::ivec3 origin = frame.m_origin + glm::ivec3(child_idx & 1, (child_idx >> 1) & 1, (child_idx >> 2) & 1) * (1 << shift);
+
+                uint32_t child_val = data[node_idx];
+                if ((child_val & 0x80000000) != 0)  // Parent node
+                {
+                    m_stack[++m_top] =
+                        Frame{.m_children_idx = child_val & 0x7FFFFFFF, .m_next_child = 0, .m_morton_code = morton_code, .m_origin = origin};
+                }
+                else if (child_val > 0)  // Leaf node
+                {
+                    m_leaf = Leaf{.m_value = child_val, .m_level = level, .m_morton_code = morton_code, .m_position = origin};
+                    return;
+                }
+            }
+        }
+    };
+
+    class Octree::LeafRange
+    {
+    private:
+        Octree const &m_octree;
+
+    public:
+        explicit LeafRange(Octree const &octree) :
+            m_octree(octree)
+        {
+        }
+
+        LeafIterator begin() const { return LeafIterator(m_octree); }
+        std::default_sentinel_t end() const { return std::default_sentinel; }
+    };
+
+    inline Octree::LeafRange Octree::leaves() const
+    {
+        return LeafRange(*this);
+    }
+
+    template <typename _VisitorT>
+    void Octree::for_each_leaf(_VisitorT &&visitor) const
+    {
+        for (Leaf const &leaf : leaves()) visitor(leaf);
+    }
 }  // namespace explo
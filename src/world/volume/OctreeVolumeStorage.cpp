@@ -0,0 +1,42 @@
+#include "OctreeVolumeStorage.hpp"
+
+#include <algorithm>
+#include <glm/gtc/integer.hpp>
+
+#include "util/misc.hpp"
+
+using namespace explo;
+
+namespace
+{
+    uint32_t get_octree_depth(glm::ivec3 const &size)
+    {
+        uint32_t max_side = std::max(std::max(size.x, size.y), size.z);
+        return glm::log2(ceil_to_power_of_2(max_side));
+    }
+}  // namespace
+
+OctreeVolumeStorage::OctreeVolumeStorage(glm::ivec3 const &size, Octree::Layout layout) :
+    m_octree(get_octree_depth(size), layout)
+{
+}
+
+uint8_t OctreeVolumeStorage::get_block_type_at(glm::ivec3 const &block_pos) const
+{
+    return m_octree.get_voxel_at(Octree::to_morton_code(block_pos));
+}
+
+void OctreeVolumeStorage::set_block_type_at(glm::ivec3 const &block_pos, uint8_t block_type)
+{
+    m_octree.set_voxel_at(Octree::to_morton_code(block_pos), block_type);
+}
+
+void OctreeVolumeStorage::fill_block_type(glm::ivec3 const &from, glm::ivec3 const &to, uint8_t block_type)
+{
+    m_octree.fill_voxels(from, to, block_type);
+}
+
+void OctreeVolumeStorage::optimize()
+{
+    m_octree.compact();
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Octree.hpp"
+#include "VolumeStorage.hpp"
+
+namespace explo
+{
+    /// Stores the blocks within an Octree (addressed by the morton code of the block position).
+    class OctreeVolumeStorage : public VolumeStorage
+    {
+    private:
+        Octree m_octree;
+
+    public:
+        /// \param size The size of the volume, the octree side is the smallest power of 2 covering it.
+        explicit OctreeVolumeStorage(glm::ivec3 const &size, Octree::Layout layout = Octree::Layout::Linear);
+        ~OctreeVolumeStorage() override = default;
+
+        VolumeStorageType get_type() const override { return VolumeStorageType::Octree; }
+
+        Octree &octree() { return m_octree; }
+        Octree const &octree() const { return m_octree; }
+
+        uint8_t get_block_type_at(glm::ivec3 const &block_pos) const override;
+        void set_block_type_at(glm::ivec3 const &block_pos, uint8_t block_type) override;
+
+        void fill_block_type(glm::ivec3 const &from, glm::ivec3 const &to, uint8_t block_type) override;
+
+        void optimize() override;
+
+        size_t get_byte_size() const override { return m_octree.size() * sizeof(uint32_t); }
+
+        /// Calls the visitor, taking the block position and the block type, for every non-empty block (merged leaves are expanded).
+        template <typename _VisitorT>
+        void for_each_block(_VisitorT &&visitor) const
+        {
+            for (Octree::Leaf const &leaf : m_octree.leaves())
+            {
+                int side = 1 << (m_octree.get_depth() - leaf.m_level - 1);
+
+                glm::ivec3 offset{};
+                for (offset.y = 0; offset.y < side; offset.y++)
+                {
+                    for (offset.z = 0; offset.z < side; offset.z++)
+                    {
+                        for (offset.x = 0; offset.x < side; offset.x++) visitor(leaf.m_position + offset, uint8_t(leaf.m_value));
+                    }
+                }
+            }
+        }
+    };
+}  // namespace explo
@@ -0,0 +1,217 @@
+#include "PaletteVolumeStorage.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace explo;
+
+// ------------------------------------------------------------------------------------------------
+// PaletteVolumeStorage::Section
+// ------------------------------------------------------------------------------------------------
+
+namespace
+{
+    /// The fewest bits, among 0, 1, 2, 4 and 8, required to index the given palette size.
+    uint32_t get_required_bits(size_t palette_size)
+    {
+        if (palette_size <= 1) return 0;
+        if (palette_size <= 2) return 1;
+        if (palette_size <= 4) return 2;
+        if (palette_size <= 16) return 4;
+        return 8;
+    }
+}  // namespace
+
+uint32_t PaletteVolumeStorage::Section::get_index(uint32_t block_idx) const
+{
+    // The bit count divides 64, hence an index never straddles two words
+    uint32_t bit_offset = block_idx * m_bits;
+    return (m_indices[bit_offset >> 6] >> (bit_offset & 63)) & ((1u << m_bits) - 1);
+}
+
+void PaletteVolumeStorage::Section::set_index(uint32_t block_idx, uint32_t index)
+{
+    uint32_t bit_offset = block_idx * m_bits;
+    uint64_t mask = uint64_t((1u << m_bits) - 1) << (bit_offset & 63);
+
+    uint64_t &word = m_indices[bit_offset >> 6];
+    word = (word & ~mask) | (uint64_t(index) << (bit_offset & 63));
+}
+
+uint8_t PaletteVolumeStorage::Section::get_block_type_at(uint32_t block_idx) const
+{
+    if (m_bits == 0) return m_palette[0];
+    return m_palette[get_index(block_idx)];
+}
+
+void PaletteVolumeStorage::Section::set_block_type_at(uint32_t block_idx, uint8_t block_type)
+{
+    auto palette_it = std::find(m_palette.begin(), m_palette.end(), block_type);
+    uint32_t index = palette_it - m_palette.begin();
+
+    if (palette_it == m_palette.end())
+    {
+        m_palette.push_back(block_type);
+
+        uint32_t required_bits = get_required_bits(m_palette.size());
+        if (required_bits > m_bits) repack(required_bits);
+    }
+    else if (m_bits == 0)
+    {
+        return;  // The only block type of the section
+    }
+
+    set_index(block_idx, index);
+}
+
+void PaletteVolumeStorage::Section::fill(uint8_t block_type)
+{
+    m_palette.assign(1, block_type);
+    m_bits = 0;
+    m_indices.clear();
+    m_indices.shrink_to_fit();
+}
+
+void PaletteVolumeStorage::Section::repack(uint32_t bits)
+{
+    Section section{};
+    section.m_bits = bits;
+    section.m_indices.resize(bits * k_section_block_count / 64);
+
+    if (bits > 0)
+    {
+        for (uint32_t block_idx = 0; block_idx < k_section_block_count; block_idx++)
+            section.set_index(block_idx, m_bits > 0 ? get_index(block_idx) : 0);
+    }
+
+    m_bits = section.m_bits;
+    m_indices = std::move(section.m_indices);
+}
+
+void PaletteVolumeStorage::Section::optimize()
+{
+    if (m_bits == 0) return;
+
+    // Count the blocks referencing every palette entry
+    uint32_t counts[256]{};
+    for (uint32_t block_idx = 0; block_idx < k_section_block_count; block_idx++) counts[get_index(block_idx)]++;
+
+    std::vector<uint8_t> palette{};
+    uint32_t remap[256]{};
+    for (uint32_t index = 0; index < m_palette.size(); index++)
+    {
+        if (counts[index] == 0) continue;
+
+        remap[index] = palette.size();
+        palette.push_back(m_palette[index]);
+    }
+
+    uint32_t bits = get_required_bits(palette.size());
+    if (palette.size() == m_palette.size() && bits == m_bits) return;
+
+    Section section{};
+    section.m_palette = std::move(palette);
+    section.m_bits = bits;
+    section.m_indices.resize(bits * k_section_block_count / 64);
+
+    if (bits > 0)
+    {
+        for (uint32_t block_idx = 0; block_idx < k_section_block_count; block_idx++) section.set_index(block_idx, remap[get_index(block_idx)]);
+    }
+
+    *this = std::move(section);
+}
+
+// ------------------------------------------------------------------------------------------------
+// PaletteVolumeStorage
+// ------------------------------------------------------------------------------------------------
+
+PaletteVolumeStorage::PaletteVolumeStorage(glm::ivec3 const &size) :
+    m_size(size),
+    m_section_count(size / k_section_side)
+{
+    assert(m_section_count * k_section_side == m_size);
+
+    m_sections.resize(m_section_count.x * m_section_count.y * m_section_count.z);
+}
+
+size_t PaletteVolumeStorage::to_section_index(glm::ivec3 const &block_pos) const
+{
+    glm::ivec3 section_pos = block_pos / k_section_side;
+    return (size_t(section_pos.y) * m_section_count.z + section_pos.z) * m_section_count.x + section_pos.x;
+}
+
+glm::ivec3 PaletteVolumeStorage::to_section_origin(size_t section_idx) const
+{
+    int x = section_idx % m_section_count.x;
+    int z = (section_idx / m_section_count.x) % m_section_count.z;
+    int y = section_idx / (m_section_count.x * m_section_count.z);
+    return glm::ivec3(x, y, z) * k_section_side;
+}
+
+uint32_t PaletteVolumeStorage::to_section_block_index(glm::ivec3 const &block_pos)
+{
+    glm::ivec3 rel_pos = block_pos % k_section_side;
+    return (rel_pos.y * k_section_side + rel_pos.z) * k_section_side + rel_pos.x;
+}
+
+uint8_t PaletteVolumeStorage::get_block_type_at(glm::ivec3 const &block_pos) const
+{
+    return m_sections[to_section_index(block_pos)].get_block_type_at(to_section_block_index(block_pos));
+}
+
+void PaletteVolumeStorage::set_block_type_at(glm::ivec3 const &block_pos, uint8_t block_type)
+{
+    m_sections[to_section_index(block_pos)].set_block_type_at(to_section_block_index(block_pos), block_type);
+}
+
+void PaletteVolumeStorage::fill_block_type(glm::ivec3 const &from, glm::ivec3 const &to, uint8_t block_type)
+{
+    glm::ivec3 section_from = from / k_section_side;
+    glm::ivec3 section_to = (to + k_section_side - 1) / k_section_side;
+
+    glm::ivec3 section_pos{};
+    for (section_pos.y = section_from.y; section_pos.y < section_to.y; section_pos.y++)
+    {
+        for (section_pos.z = section_from.z; section_pos.z < section_to.z; section_pos.z++)
+        {
+            for (section_pos.x = section_from.x; section_pos.x < section_to.x; section_pos.x++)
+            {
+                glm::ivec3 origin = section_pos * k_section_side;
+                Section &section = m_sections[to_section_index(origin)];
+
+                glm::ivec3 box_from = glm::max(from, origin);
+                glm::ivec3 box_to = glm::min(to, origin + k_section_side);
+
+                // The section is entirely covered by the box
+                if (box_to - box_from == glm::ivec3(k_section_side))
+                {
+                    section.fill(block_type);
+                    continue;
+                }
+
+                glm::ivec3 block_pos{};
+                for (block_pos.y = box_from.y; block_pos.y < box_to.y; block_pos.y++)
+                {
+                    for (block_pos.z = box_from.z; block_pos.z < box_to.z; block_pos.z++)
+                    {
+                        for (block_pos.x = box_from.x; block_pos.x < box_to.x; block_pos.x++)
+                            section.set_block_type_at(to_section_block_index(block_pos), block_type);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void PaletteVolumeStorage::optimize()
+{
+    for (Section &section : m_sections) section.optimize();
+}
+
+size_t PaletteVolumeStorage::get_byte_size() const
+{
+    size_t byte_size = 0;
+    for (Section const &section : m_sections) byte_size += section.get_byte_size();
+    return byte_size;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+
+#include "VolumeStorage.hpp"
+
+namespace explo
+{
+    /// Splits the volume in sections of 16x16x16 blocks, every section stores a palette of the block types it contains and, per block,
+    /// the index within the palette, bit-packed using 0, 1, 2, 4 or 8 bits (depending on the palette size).
+    class PaletteVolumeStorage : public VolumeStorage
+    {
+    public:
+        static constexpr int k_section_side = 16;
+        static constexpr int k_section_block_count = k_section_side * k_section_side * k_section_side;
+
+        struct Section
+        {
+            std::vector<uint8_t> m_palette{0};  ///< The block types of the section, initially air only
+            uint32_t m_bits = 0;                 ///< Bits per block index, 0 means every block is m_palette[0]
+            std::vector<uint64_t> m_indices;     ///< Bit-packed palette indices (k_section_block_count * m_bits bits)
+
+            uint8_t get_block_type_at(uint32_t block_idx) const;
+            void set_block_type_at(uint32_t block_idx, uint8_t block_type);
+
+            /// Sets every block of the section to the given block type.
+            void fill(uint8_t block_type);
+
+            /// Drops the unused palette entries and repacks the indices with the fewest bits possible.
+            void optimize();
+
+            size_t get_byte_size() const { return m_palette.size() + m_indices.size() * sizeof(uint64_t); }
+
+        private:
+            uint32_t get_index(uint32_t block_idx) const;
+            void set_index(uint32_t block_idx, uint32_t index);
+
+            /// Re-encodes the indices using the given bit count.
+            void repack(uint32_t bits);
+        };
+
+    private:
+        glm::ivec3 m_size;
+        glm::ivec3 m_section_count;
+        std::vector<Section> m_sections;
+
+    public:
+        /// \param size The size of the volume, must be a multiple of the section side.
+        explicit PaletteVolumeStorage(glm::ivec3 const &size);
+        ~PaletteVolumeStorage() override = default;
+
+        VolumeStorageType get_type() const override { return VolumeStorageType::Palette; }
+
+        std::vector<Section> const &get_sections() const { return m_sections; }
+
+        uint8_t get_block_type_at(glm::ivec3 const &block_pos) const override;
+        void set_block_type_at(glm::ivec3 const &block_pos, uint8_t block_type) override;
+
+        void fill_block_type(glm::ivec3 const &from, glm::ivec3 const &to, uint8_t block_type) override;
+
+        void optimize() override;
+
+        size_t get_byte_size() const override;
+
+        /// Calls the visitor, taking the block position and the block type, for every non-empty block.
+        template <typename _VisitorT>
+        void for_each_block(_VisitorT &&visitor) const
+        {
+            for (size_t section_idx = 0; section_idx < m_sections.size(); section_idx++)
+            {
+                Section const &section = m_sections[section_idx];
+                if (section.m_bits == 0 && section.m_palette[0] == 0) continue;  // Air only
+
+                glm::ivec3 origin = to_section_origin(section_idx);
+
+                uint32_t block_idx = 0;
+                glm::ivec3 offset{};
+                for (offset.y = 0; offset.y < k_section_side; offset.y++)
+                {
+                    for (offset.z = 0; offset.z < k_section_side; offset.z++)
+                    {
+                        for (offset.x = 0; offset.x < k_section_side; offset.x++, block_idx++)
+                        {
+                            uint8_t block_type = section.get_block_type_at(block_idx);
+                            if (block_type != 0) visitor(origin + offset, block_type);
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        size_t to_section_index(glm::ivec3 const &block_pos) const;
+        glm::ivec3 to_section_origin(size_t section_idx) const;
+
+        static uint32_t to_section_block_index(glm::ivec3 const &block_pos);
+    };
+}  // namespace explo
@@ -39,23 +39,16 @@ void PerlinNoiseGenerator::generate_volume(Chunk &chunk)
                 min_neighbor_y = glm::min(get_height_at(block_pos.x - 1, block_pos.z + 1), min_neighbor_y);
                 min_neighbor_y = glm::min(get_height_at(block_pos.x - 1, block_pos.z - 1), min_neighbor_y);
 
-                // TODO pick block types from BlockRegistry (e.g. as enums)
-                chunk.set_block_type_at(chunk.to_chunk_position(block_pos), 1);  // Grass
-                block_pos.y--;
-
                 int dirt_height = (int)(m_perlin_noise.noise2D(x ^ 3508739221, z ^ 2024663696) + 2.0);
+                int dirt_from_y = glm::max(base_y - dirt_height, min_neighbor_y + 1);
 
-                for (int i = 0; block_pos.y > min_neighbor_y && i < dirt_height; block_pos.y--, i++)
-                {
-                    if (!chunk.test_block_position(block_pos)) break;
-                    chunk.set_block_type_at(chunk.to_chunk_position(block_pos), 2);  // Dirt
-                }
-
-                for (; block_pos.y > min_neighbor_y; block_pos.y--)
-                {
-                    if (!chunk.test_block_position(block_pos)) break;
-                    chunk.set_block_type_at(chunk.to_chunk_position(block_pos), 3);  // Stone
-                }
+                // The runs below the surface are written in bulk (whole octree nodes are written at once when covered)
+                int chunk_base_y = chunk.to_world_block_position(glm::ivec3(0)).y;
+
+                // TODO pick block types from BlockRegistry (e.g. as enums)
+                chunk.set_block_type_at(glm::ivec3(x, base_y - chunk_base_y, z), 1);                                    // Grass
+                chunk.fill_block_type_column(x, z, dirt_from_y - chunk_base_y, base_y - chunk_base_y, 2);               // Dirt
+                chunk.fill_block_type_column(x, z, min_neighbor_y + 1 - chunk_base_y, dirt_from_y - chunk_base_y, 3);  // Stone
             }
         }
     }
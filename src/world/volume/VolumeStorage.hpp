@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace explo
+{
+    enum class VolumeStorageType
+    {
+        Dense,   ///< One byte per block: O(1) reads and writes, fixed (and large) memory usage
+        Octree,  ///< Sparse: memory depends on the volume complexity, reads and writes descend the tree
+        Palette  ///< 16x16x16 sections of bit-packed palette indices: O(1) reads and writes, memory depends on the block types per section
+    };
+
+    /// The storage of the blocks of a chunk. Positions are relative to the chunk and are expected to be inside of it.
+    class VolumeStorage
+    {
+    public:
+        explicit VolumeStorage() = default;
+        virtual ~VolumeStorage() = default;
+
+        virtual VolumeStorageType get_type() const = 0;
+
+        virtual uint8_t get_block_type_at(glm::ivec3 const &block_pos) const = 0;
+        virtual void set_block_type_at(glm::ivec3 const &block_pos, uint8_t block_type) = 0;
+
+        /// Sets the block type of every block within the box [from, to).
+        virtual void fill_block_type(glm::ivec3 const &from, glm::ivec3 const &to, uint8_t block_type) = 0;
+
+        /// Reduces the memory used by the storage, intended to be called once the volume isn't expected to change.
+        virtual void optimize() {}
+
+        /// The memory, in bytes, used to store the blocks.
+        virtual size_t get_byte_size() const = 0;
+    };
+}  // namespace explo
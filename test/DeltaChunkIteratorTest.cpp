@@ -1,6 +1,9 @@
 #include <catch.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "log.hpp"
 #include "world/DeltaChunkIterator.hpp"
@@ -194,3 +197,52 @@ TEST_CASE("DeltaChunkIterator-checkLoadUnloadOnOffset")
 
     CHECK(loaded_chunks.size() == size);
 }
+
+TEST_CASE("DeltaChunkIterator-MatchesBruteForce")
+{
+    // Randomized differential test: the iterated chunks must be exactly the chunks of the new world view that are outside of the old one,
+    // each of them once
+    std::mt19937 random_engine(42);
+    std::uniform_int_distribution<int> render_distance_distribution(0, 4);
+    std::uniform_int_distribution<int> offset_distribution(-10, 10);
+
+    for (int i = 0; i < 2000; i++)
+    {
+        glm::ivec3 render_distance(
+            render_distance_distribution(random_engine), render_distance_distribution(random_engine), render_distance_distribution(random_engine)
+        );
+        glm::ivec3 old_center(offset_distribution(random_engine), offset_distribution(random_engine), offset_distribution(random_engine));
+        glm::ivec3 new_center = old_center;
+        new_center[i % 3] += offset_distribution(random_engine);  // Moves along one axis at least (or not at all)
+        if (i % 2 == 0) new_center += glm::ivec3(offset_distribution(random_engine), 0, offset_distribution(random_engine)) / 3;
+
+        std::unordered_set<glm::ivec3, vec_hash> expected_chunks{};
+        WorldView::iterate_chunks(
+            new_center,
+            render_distance,
+            [&](glm::ivec3 const &chunk_pos)
+            {
+                if (!WorldView::is_chunk_position_inside(old_center, render_distance, chunk_pos)) expected_chunks.emplace(chunk_pos);
+            }
+        );
+
+        std::unordered_map<glm::ivec3, int, vec_hash> visit_counts{};
+        DeltaChunkIterator iterator(
+            old_center,
+            new_center,
+            render_distance,
+            [&](glm::ivec3 const &chunk_pos)
+            {
+                visit_counts[chunk_pos]++;
+            }
+        );
+        iterator.iterate();
+
+        REQUIRE(visit_counts.size() == expected_chunks.size());
+        for (auto const &[chunk_pos, visit_count] : visit_counts)
+        {
+            REQUIRE(visit_count == 1);
+            REQUIRE(expected_chunks.contains(chunk_pos));
+        }
+    }
+}
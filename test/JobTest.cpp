@@ -0,0 +1,200 @@
+#include <array>
+#include <atomic>
+#include <catch.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "util/Job.hpp"
+#include "util/JobToken.hpp"
+#include "util/SmallVector.hpp"
+#include "util/SyncJobExecutor.hpp"
+#include "util/TaskGraph.hpp"
+#include "util/ThreadPool.hpp"
+
+using namespace explo;
+
+// ------------------------------------------------------------------------------------------------
+// Allocation counting, for the whole test executable (built apart from explo_test for this reason)
+// ------------------------------------------------------------------------------------------------
+
+namespace
+{
+    std::atomic<size_t> allocation_count = 0;
+
+    void *allocate(size_t size, size_t alignment) noexcept
+    {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+        if (size == 0) size = 1;
+        if (alignment <= alignof(std::max_align_t)) return std::malloc(size);
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);  // The size must be a multiple of the alignment
+    }
+
+    void *allocate_or_throw(size_t size, size_t alignment)
+    {
+        if (void *ptr = allocate(size, alignment)) return ptr;
+        throw std::bad_alloc();
+    }
+}  // namespace
+
+// Every overload is replaced, otherwise the memory allocated by the default ones (e.g. nothrow) would be freed by the replaced ones
+// clang-format off
+void *operator new(size_t size) { return allocate_or_throw(size, 0); }
+void *operator new[](size_t size) { return allocate_or_throw(size, 0); }
+void *operator new(size_t size, std::align_val_t alignment) { return allocate_or_throw(size, size_t(alignment)); }
+void *operator new[](size_t size, std::align_val_t alignment) { return allocate_or_throw(size, size_t(alignment)); }
+void *operator new(size_t size, std::nothrow_t const &) noexcept { return allocate(size, 0); }
+void *operator new[](size_t size, std::nothrow_t const &) noexcept { return allocate(size, 0); }
+void *operator new(size_t size, std::align_val_t alignment, std::nothrow_t const &) noexcept { return allocate(size, size_t(alignment)); }
+void *operator new[](size_t size, std::align_val_t alignment, std::nothrow_t const &) noexcept { return allocate(size, size_t(alignment)); }
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::nothrow_t const &) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::nothrow_t const &) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t, std::nothrow_t const &) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t, std::nothrow_t const &) noexcept { std::free(ptr); }
+// clang-format on
+
+// ------------------------------------------------------------------------------------------------
+// Tests
+// ------------------------------------------------------------------------------------------------
+
+TEST_CASE("Job-SmallBufferAndPooling")
+{
+    std::shared_ptr<int> resource = std::make_shared<int>(0);
+
+    // A small callable is stored inline
+    size_t allocations_before = allocation_count.load();
+    {
+        Job job(
+            [resource]()
+            {
+                (*resource)++;
+            }
+        );
+        Job moved_job = std::move(job);
+        moved_job();
+
+        REQUIRE(!job);
+        REQUIRE(moved_job);
+    }
+    REQUIRE(allocation_count.load() == allocations_before);
+    REQUIRE(*resource == 1);
+    REQUIRE(resource.use_count() == 1);
+
+    // A large one is stored in a pooled block, reused once released
+    auto create_large_job = [&resource]()
+    {
+        return Job(
+            [resource, padding = std::array<char, 200>{}]()
+            {
+                (*resource) += int(padding.size());
+            }
+        );
+    };
+    create_large_job()();
+
+    allocations_before = allocation_count.load();
+    {
+        Job job = create_large_job();
+        job();
+        job = nullptr;
+
+        REQUIRE(resource.use_count() == 1);
+    }
+    REQUIRE(allocation_count.load() == allocations_before);
+    REQUIRE(*resource == 401);
+}
+
+TEST_CASE("TaskGraph-AllocationFreeChunkPipeline")
+{
+    // Builds the graphs World::generate_chunk_async builds: a volume task, a surface task waiting for the volume of the chunk and of its
+    // loaded neighbours, then a callback enqueuing the upload on the main thread. Once warm, the pipelines must not allocate
+    size_t const k_pipeline_count = 100;
+    size_t const k_neighbour_count = 6;
+
+    ThreadPool thread_pool(2);
+    SyncJobExecutor main_thread_executor{};
+
+    std::shared_ptr<JobToken> token = std::make_shared<JobToken>();
+    std::shared_ptr<int> chunk = std::make_shared<int>(0);
+    std::shared_ptr<int> world = std::make_shared<int>(0);
+
+    std::atomic<size_t> uploaded_count = 0;
+
+    std::vector<std::shared_ptr<Task>> volume_tasks(k_pipeline_count * 4);
+
+    auto run_pipelines = [&](size_t pipeline_count)
+    {
+        uploaded_count = 0;
+        for (size_t i = 0; i < pipeline_count; i++)
+        {
+            TaskGraph task_graph(token);
+
+            std::shared_ptr<Task> volume_task = task_graph.add(
+                [weak_world = std::weak_ptr(world), weak_chunk = std::weak_ptr(chunk)]()
+                {
+                    if (std::shared_ptr<int> chunk = weak_chunk.lock()) (*chunk)++;
+                }
+            );
+
+            SmallVector<std::shared_ptr<Task>, 1 + k_neighbour_count> surface_predecessors{};
+            surface_predecessors.push_back(volume_task);
+            for (size_t j = 1; j <= k_neighbour_count && j <= i; j++) surface_predecessors.push_back(volume_tasks[i - j]);
+
+            std::shared_ptr<Task> surface_task = task_graph.add(
+                [weak_world = std::weak_ptr(world), weak_chunk = std::weak_ptr(chunk)]()
+                {
+                    if (std::shared_ptr<int> chunk = weak_chunk.lock()) (*chunk)++;
+                },
+                surface_predecessors
+            );
+
+            task_graph.add(
+                [&main_thread_executor, &uploaded_count, weak_chunk = std::weak_ptr(chunk)]()
+                {
+                    main_thread_executor.enqueue_job(
+                        [&uploaded_count, weak_chunk]()
+                        {
+                            if (weak_chunk.lock()) uploaded_count++;
+                        }
+                    );
+                },
+                {surface_task}
+            );
+
+            task_graph.dispatch(thread_pool);
+            volume_tasks[i] = std::move(volume_task);
+        }
+
+        while (uploaded_count.load() < pipeline_count)
+        {
+            main_thread_executor.process();
+            std::this_thread::yield();
+        }
+
+        for (std::shared_ptr<Task> &volume_task : volume_tasks) volume_task = nullptr;
+    };
+
+    // Overprovision the pools: the blocks released by the workers are only given back once their caches are full
+    for (int i = 0; i < 4; i++) run_pipelines(k_pipeline_count * 4);
+    for (int i = 0; i < 4; i++) run_pipelines(k_pipeline_count);
+
+    size_t allocations_before = allocation_count.load();
+    run_pipelines(k_pipeline_count);
+    size_t allocations_after = allocation_count.load();
+
+    REQUIRE(allocations_after == allocations_before);
+}
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <catch.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "util/LatencyHistogram.hpp"
+
+using namespace explo;
+
+TEST_CASE("LatencyHistogram-Buckets")
+{
+    // Every value falls within its bucket, and the buckets are contiguous
+    for (uint32_t bucket_index = 0; bucket_index + 1 < LatencyHistogram::k_bucket_count; bucket_index++)
+    {
+        uint64_t lower_bound = LatencyHistogram::get_bucket_lower_bound(bucket_index);
+        uint64_t width = LatencyHistogram::get_bucket_width(bucket_index);
+
+        REQUIRE(LatencyHistogram::get_bucket_index(lower_bound) == bucket_index);
+        REQUIRE(LatencyHistogram::get_bucket_index(lower_bound + width - 1) == bucket_index);
+        REQUIRE(LatencyHistogram::get_bucket_lower_bound(bucket_index + 1) == lower_bound + width);
+    }
+
+    REQUIRE(LatencyHistogram::get_bucket_index(UINT64_MAX) == LatencyHistogram::k_bucket_count - 1);
+}
+
+TEST_CASE("LatencyHistogram-Quantiles")
+{
+    LatencyHistogram histogram{};
+    REQUIRE(histogram.get_quantile(0.5) == 0);
+
+    // Log-normal latencies around 2 ms, as the chunk generation
+    std::mt19937 random(42);
+    std::lognormal_distribution<double> distribution(std::log(2'000'000.0), 0.8);
+
+    std::vector<uint64_t> samples;
+    for (int i = 0; i < 100000; i++)
+    {
+        uint64_t sample = uint64_t(distribution(random));
+        samples.push_back(sample);
+        histogram.record(sample);
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    REQUIRE(histogram.get_count() == samples.size());
+    REQUIRE(histogram.get_max() == samples.back());
+
+    for (double quantile : {0.5, 0.95, 0.99, 0.999})
+    {
+        double expected = double(samples[size_t(std::ceil(quantile * samples.size())) - 1]);
+        double relative_error = std::abs(double(histogram.get_quantile(quantile)) - expected) / expected;
+        REQUIRE(relative_error <= 1.0 / LatencyHistogram::k_sub_bucket_count);
+    }
+
+    REQUIRE(histogram.get_quantile(1.0) == samples.back());
+
+    histogram.reset();
+    REQUIRE(histogram.get_count() == 0);
+    REQUIRE(histogram.get_quantile(0.99) == 0);
+}
+
+TEST_CASE("LatencyHistogram-ConcurrentRecord")
+{
+    size_t const k_thread_count = 4;
+    size_t const k_sample_count = 100000;
+
+    LatencyHistogram histogram{};
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < k_thread_count; i++)
+    {
+        threads.emplace_back(
+            [&histogram, i]()
+            {
+                for (size_t j = 0; j < k_sample_count; j++) histogram.record(i * k_sample_count + j);
+            }
+        );
+    }
+    for (std::thread &thread : threads) thread.join();
+
+    REQUIRE(histogram.get_count() == k_thread_count * k_sample_count);
+    REQUIRE(histogram.get_max() == k_thread_count * k_sample_count - 1);
+    REQUIRE(histogram.get_mean() == (k_thread_count * k_sample_count - 1) / 2.0);
+}
@@ -1,5 +1,14 @@
+#include <algorithm>
 #include <catch.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <glm/glm.hpp>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include "util/SmallVector.hpp"
 #include "util/misc.hpp"
 
 using namespace explo;
@@ -16,4 +25,91 @@ TEST_CASE("misc-pmod")
     REQUIRE(pmod(v + 1, n) == 1);
     REQUIRE(pmod(v + 2, n) == 2);
     REQUIRE(pmod(v + 3, n) == 0);
-}
\ No newline at end of file
+}
+TEST_CASE("misc-SmallVector")
+{
+    std::shared_ptr<int> element = std::make_shared<int>(0);
+
+    SmallVector<std::shared_ptr<int>, 2> small_vector{};
+    small_vector.push_back(element);
+    small_vector.push_back(element);
+    REQUIRE(small_vector.is_inline());
+
+    // Spill to the heap, keeping the elements contiguous
+    small_vector.push_back(element);
+    REQUIRE(!small_vector.is_inline());
+    REQUIRE(small_vector.size() == 3);
+    for (std::shared_ptr<int> const &small_vector_element : small_vector) REQUIRE(small_vector_element == element);
+    REQUIRE(element.use_count() == 4);
+
+    // Back to the inline storage, the elements are released
+    small_vector.clear();
+    REQUIRE(small_vector.is_inline());
+    REQUIRE(small_vector.empty());
+    REQUIRE(element.use_count() == 1);
+}
+
+namespace
+{
+    /// The render area of a 32 chunks render distance (65x1x65), centered on the origin.
+    std::vector<glm::ivec3> get_render_area_positions()
+    {
+        std::vector<glm::ivec3> positions;
+        for (int x = -32; x <= 32; x++)
+        {
+            for (int z = -32; z <= 32; z++) positions.emplace_back(x, 0, z);
+        }
+        return positions;
+    }
+
+    /// The previous vec_hash, XORing the components.
+    struct xor_vec_hash
+    {
+        size_t operator()(glm::ivec3 const &vec) const { return size_t(vec.x) ^ size_t(vec.y) ^ size_t(vec.z); }
+    };
+
+    template <typename _HashT>
+    size_t insert_and_lookup(std::vector<glm::ivec3> const &positions)
+    {
+        std::unordered_map<glm::ivec3, size_t, _HashT> map;
+        for (size_t i = 0; i < positions.size(); i++) map.emplace(positions[i], i);
+
+        size_t sum = 0;
+        for (glm::ivec3 const &position : positions) sum += map.find(position)->second;
+        return sum;
+    }
+}  // namespace
+
+TEST_CASE("misc-vec_hash")
+{
+    std::vector<glm::ivec3> positions = get_render_area_positions();
+
+    // No two positions of the render area share a hash, even permuted ones
+    std::unordered_set<size_t> hashes;
+    for (glm::ivec3 const &position : positions) hashes.insert(vec_hash{}(position));
+    REQUIRE(hashes.size() == positions.size());
+    REQUIRE(vec_hash{}(glm::ivec3(1, 0, 2)) != vec_hash{}(glm::ivec3(2, 0, 1)));
+
+    // And they spread over the buckets of a map
+    std::unordered_map<glm::ivec3, size_t, vec_hash> map;
+    for (glm::ivec3 const &position : positions) map.emplace(position, 0);
+
+    size_t max_bucket_size = 0;
+    for (size_t bucket = 0; bucket < map.bucket_count(); bucket++) max_bucket_size = std::max(map.bucket_size(bucket), max_bucket_size);
+    REQUIRE(max_bucket_size <= 8);
+}
+
+TEST_CASE("misc-vec_hash-Benchmark", "[.benchmark]")
+{
+    std::vector<glm::ivec3> positions = get_render_area_positions();
+
+    BENCHMARK("XOR hash; Render area: 65x1x65")
+    {
+        return insert_and_lookup<xor_vec_hash>(positions);
+    };
+
+    BENCHMARK("vec_hash; Render area: 65x1x65")
+    {
+        return insert_and_lookup<vec_hash>(positions);
+    };
+}
@@ -1,8 +1,14 @@
 #include <catch.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <glm/glm.hpp>
 #include <random>
 
+#include "world/World.hpp"
+#include "world/surface/BlockySurfaceGenerator.hpp"
 #include "world/volume/Octree.hpp"
+#include "world/volume/OctreeVolumeStorage.hpp"
+#include "world/volume/PerlinNoiseGenerator.hpp"
 
 using namespace explo;
 
@@ -30,6 +36,59 @@ TEST_CASE("OctreeVolumeStorage-MortonCode")
     }
 }
 
+TEST_CASE("OctreeVolumeStorage-MortonCode-ChunkDomain")
+{
+    // Reference bit interleaving (one bit per axis at a time)
+    auto interleave = [](glm::ivec3 const &pos)
+    {
+        uint32_t morton_code = 0;
+        for (int i = 0; i < 10; i++)
+            morton_code |= (((pos.x >> i) & 1) | (((pos.y >> i) & 1) << 1) | (((pos.z >> i) & 1) << 2)) << (i * 3);
+        return morton_code;
+    };
+
+    glm::ivec3 pos{};
+    for (pos.x = 0; pos.x < 16; pos.x++)
+    {
+        for (pos.y = 0; pos.y < 256; pos.y++)
+        {
+            for (pos.z = 0; pos.z < 16; pos.z++)
+            {
+                uint32_t morton_code = Octree::to_morton_code(pos);
+                REQUIRE(morton_code == interleave(pos));
+                REQUIRE(Octree::to_voxel_position(morton_code) == pos);
+            }
+        }
+    }
+
+    // Upper bound: 10 bits per axis
+    REQUIRE(Octree::to_voxel_position(Octree::to_morton_code(glm::ivec3(1023, 513, 1022))) == glm::ivec3(1023, 513, 1022));
+}
+
+TEST_CASE("OctreeVolumeStorage-Benchmark-MortonCode", "[.benchmark]")
+{
+    BENCHMARK("to_morton_code")
+    {
+        uint32_t result = 0;
+        glm::ivec3 pos{};
+        for (pos.x = 0; pos.x < 16; pos.x++)
+        {
+            for (pos.y = 0; pos.y < 256; pos.y++)
+            {
+                for (pos.z = 0; pos.z < 16; pos.z++) result ^= Octree::to_morton_code(pos);
+            }
+        }
+        return result;
+    };
+
+    BENCHMARK("to_voxel_position")
+    {
+        glm::ivec3 result{};
+        for (uint32_t morton_code = 0; morton_code < 16 * 256 * 16; morton_code++) result += Octree::to_voxel_position(morton_code);
+        return result;
+    };
+}
+
 TEST_CASE("OctreeVolumeStorage-SetGet-Traverse")
 {
     Octree octree(4);  // Depth: 4, Octree: 16x16x16
@@ -52,3 +111,329 @@ TEST_CASE("OctreeVolumeStorage-SetGet-Traverse")
     );
     REQUIRE(found);
 }
+
+TEST_CASE("Octree-LeafIterator")
+{
+    Octree::Layout layout = GENERATE(Octree::Layout::Linear, Octree::Layout::Packed);
+
+    Octree octree(5, layout);
+
+    std::mt19937 random(1234);
+    for (int i = 0; i < 2000; i++) octree.set_voxel_at(random() % (32 * 32 * 32), random() % 3, true);
+    octree.fill_voxels(glm::ivec3(0, 0, 0), glm::ivec3(32, 8, 32), 3);  // Produces merged leaves
+
+    size_t voxel_count = 0;
+    size_t leaf_count = 0;
+    uint32_t last_morton_code = 0;
+    for (Octree::Leaf const &leaf : octree.leaves())
+    {
+        REQUIRE(leaf.m_value != 0);
+        REQUIRE(leaf.m_position == Octree::to_voxel_position(leaf.m_morton_code));
+        REQUIRE(octree.get_voxel_at(leaf.m_morton_code) == leaf.m_value);
+        REQUIRE((leaf_count == 0 || leaf.m_morton_code > last_morton_code));  // Morton order
+
+        last_morton_code = leaf.m_morton_code;
+        voxel_count += size_t(1) << ((octree.get_depth() - leaf.m_level - 1) * 3);
+        leaf_count++;
+    }
+
+    size_t expected_voxel_count = 0;
+    for (uint32_t morton_code = 0; morton_code < 32 * 32 * 32; morton_code++) expected_voxel_count += octree.get_voxel_at(morton_code) != 0;
+    REQUIRE(voxel_count == expected_voxel_count);
+
+    // The std::function based traversal is a wrapper of the iterator
+    size_t traversed_leaf_count = 0;
+    octree.traverse(
+        [&](uint32_t value, uint32_t level, uint32_t morton_code)
+        {
+            traversed_leaf_count++;
+        }
+    );
+    REQUIRE(traversed_leaf_count == leaf_count);
+}
+
+// ------------------------------------------------------------------------------------------------ Compaction
+
+namespace
+{
+    /// Fills the chunk-sized octree with solid ground (stone, dirt and grass) up to the given height.
+    void fill_ground(Octree &octree, int height, bool merge)
+    {
+        for (int x = 0; x < 16; x++)
+        {
+            for (int z = 0; z < 16; z++)
+            {
+                for (int y = 0; y < height; y++)
+                {
+                    uint32_t block_type = y < height - 4 ? 3 : (y < height - 1 ? 2 : 1);
+                    octree.set_voxel_at(Octree::to_morton_code(glm::ivec3(x, y, z)), block_type, merge);
+                }
+            }
+        }
+    }
+}  // namespace
+
+TEST_CASE("Octree-Compact")
+{
+    Octree::Layout layout = GENERATE(Octree::Layout::Linear, Octree::Layout::Packed);
+
+    Octree octree(8, layout);
+    fill_ground(octree, 100, false);
+
+    Octree compacted = octree;
+    compacted.compact();
+
+    Octree merged(8, layout);
+    fill_ground(merged, 100, true);
+
+    // Uniform stone and air regions are collapsed: that's at least an order of magnitude less memory
+    CHECK(compacted.size() * 10 <= octree.size());
+    CHECK(merged.size() < octree.size());
+
+    glm::ivec3 block_pos{};
+    for (block_pos.x = 0; block_pos.x < 16; block_pos.x++)
+    {
+        for (block_pos.y = 0; block_pos.y < 256; block_pos.y++)
+        {
+            for (block_pos.z = 0; block_pos.z < 16; block_pos.z++)
+            {
+                uint32_t morton_code = Octree::to_morton_code(block_pos);
+                REQUIRE(compacted.get_voxel_at(morton_code) == octree.get_voxel_at(morton_code));
+                REQUIRE(merged.get_voxel_at(morton_code) == octree.get_voxel_at(morton_code));
+            }
+        }
+    }
+
+    // Merged leaves must still cover every voxel
+    size_t voxel_count = 0;
+    compacted.traverse(
+        [&](uint32_t value, uint32_t level, uint32_t morton_code)
+        {
+            voxel_count += size_t(1) << ((compacted.get_depth() - level - 1) * 3);
+        }
+    );
+    REQUIRE(voxel_count == 16 * 100 * 16);
+}
+
+TEST_CASE("Octree-Compact-SplitMergedLeaf")
+{
+    Octree octree(4);
+
+    for (uint32_t morton_code = 0; morton_code < 16 * 16 * 16; morton_code++) octree.set_voxel_at(morton_code, 3, true);
+
+    // The whole volume is collapsed into the root's children, the groups went to the free list
+    octree.compact();
+    REQUIRE(octree.size() == 8);
+
+    uint32_t hole = Octree::to_morton_code(glm::ivec3(5, 6, 7));
+    octree.set_voxel_at(hole, 0, true);
+
+    for (uint32_t morton_code = 0; morton_code < 16 * 16 * 16; morton_code++)
+        REQUIRE(octree.get_voxel_at(morton_code) == (morton_code == hole ? 0 : 3));
+
+    // Filling the hole merges back the whole path, and the following split reuses the freed groups
+    octree.set_voxel_at(hole, 3, true);
+    size_t size = octree.size();
+    octree.set_voxel_at(hole, 0, true);
+    octree.set_voxel_at(hole, 3, true);
+    REQUIRE(octree.size() == size);
+}
+
+// ------------------------------------------------------------------------------------------------ Bulk fill
+
+TEST_CASE("Octree-FillVoxels")
+{
+    Octree::Layout layout = GENERATE(Octree::Layout::Linear, Octree::Layout::Packed);
+
+    Octree octree(5, layout);  // 32x32x32
+    Octree reference(5);
+
+    std::mt19937 random(1234);
+    for (int i = 0; i < 500; i++)
+    {
+        // Boxes can also lie partially outside of the octree
+        glm::ivec3 from(random() % 40 - 4, random() % 40 - 4, random() % 40 - 4);
+        glm::ivec3 to = from + glm::ivec3(random() % 20, random() % 20, random() % 20);
+        uint32_t value = random() % 3;
+
+        octree.fill_voxels(from, to, value);
+
+        glm::ivec3 pos{};
+        for (pos.x = glm::max(from.x, 0); pos.x < glm::min(to.x, 32); pos.x++)
+        {
+            for (pos.y = glm::max(from.y, 0); pos.y < glm::min(to.y, 32); pos.y++)
+            {
+                for (pos.z = glm::max(from.z, 0); pos.z < glm::min(to.z, 32); pos.z++) reference.set_voxel_at(Octree::to_morton_code(pos), value);
+            }
+        }
+    }
+
+    for (uint32_t morton_code = 0; morton_code < 32 * 32 * 32; morton_code++)
+        REQUIRE(octree.get_voxel_at(morton_code) == reference.get_voxel_at(morton_code));
+
+    // Covered nodes are written as a whole, hence the bulk filled octree never needs more nodes
+    CHECK(octree.size() <= reference.size());
+}
+
+TEST_CASE("Octree-Benchmark-FillColumn", "[.benchmark]")
+{
+    BENCHMARK("set_voxel_at")
+    {
+        Octree octree(8);
+        fill_ground(octree, 100, false);
+        return octree.size();
+    };
+
+    BENCHMARK("fill_voxels")
+    {
+        Octree octree(8);
+        for (int x = 0; x < 16; x++)
+        {
+            for (int z = 0; z < 16; z++)
+            {
+                octree.fill_voxels(glm::ivec3(x, 0, z), glm::ivec3(x + 1, 96, z + 1), 3);
+                octree.fill_voxels(glm::ivec3(x, 96, z), glm::ivec3(x + 1, 99, z + 1), 2);
+                octree.fill_voxels(glm::ivec3(x, 99, z), glm::ivec3(x + 1, 100, z + 1), 1);
+            }
+        }
+        return octree.size();
+    };
+}
+
+// ------------------------------------------------------------------------------------------------ Layouts
+
+namespace
+{
+    /// Generates a chunk using the game's volume generator and copies its voxels into an octree having the given layout.
+    Octree generate_chunk_octree(glm::ivec3 const &chunk_pos, Octree::Layout layout)
+    {
+        PerlinNoiseGenerator volume_generator{};
+        BlockySurfaceGenerator surface_generator{};
+        ThreadPool thread_pool(1);
+        World world(volume_generator, surface_generator, thread_pool);
+
+        Chunk chunk(world, chunk_pos, VolumeStorageType::Dense);
+        volume_generator.generate_volume(chunk);
+
+        OctreeVolumeStorage volume(Chunk::k_grid_size, layout);
+        chunk.for_each_block(
+            [&](glm::ivec3 const &block_pos, uint8_t block_type)
+            {
+                volume.set_block_type_at(block_pos, block_type);
+            }
+        );
+        return volume.octree();
+    }
+
+    /// Reads the neighbours of every solid voxel, the same access pattern of BlockySurfaceGenerator::write_block_geometry.
+    uint64_t read_neighbours(Octree const &octree, std::vector<glm::ivec3> const &solid_blocks)
+    {
+        static glm::ivec3 const k_offsets[]{{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
+
+        uint64_t sum = 0;
+        for (glm::ivec3 const &block : solid_blocks)
+        {
+            for (glm::ivec3 const &offset : k_offsets)
+            {
+                glm::ivec3 neighbour = block + offset;
+                if (Chunk::test_chunk_block_position(neighbour)) sum += octree.get_voxel_at(Octree::to_morton_code(neighbour));
+            }
+        }
+        return sum;
+    }
+}  // namespace
+
+TEST_CASE("Octree-Layout-PackedMatchesLinear")
+{
+    Octree::Layout layout = GENERATE(Octree::Layout::Linear, Octree::Layout::Packed);
+    uint32_t prefix_levels = GENERATE(0, 1, 2, 3);
+
+    Octree reference(8);
+    Octree octree(8, layout, prefix_levels);
+
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<uint32_t> morton_code_distribution(0, (1 << (8 * 3)) - 1);
+
+    for (int i = 0; i < 10000; i++)
+    {
+        uint32_t morton_code = morton_code_distribution(random);
+        uint32_t value = random() % 8;
+        reference.set_voxel_at(morton_code, value);
+        octree.set_voxel_at(morton_code, value);
+    }
+
+    for (int i = 0; i < 10000; i++)
+    {
+        uint32_t morton_code = morton_code_distribution(random);
+        REQUIRE(octree.get_voxel_at(morton_code) == reference.get_voxel_at(morton_code));
+    }
+
+    // Packed children groups must lie on 32-byte boundaries
+    if (layout == Octree::Layout::Packed) REQUIRE(reinterpret_cast<uintptr_t>(octree.data()) % 32 == 0);
+
+    size_t reference_count = 0, count = 0;
+    reference.traverse(
+        [&](uint32_t value, uint32_t level, uint32_t morton_code)
+        {
+            reference_count++;
+        }
+    );
+    octree.traverse(
+        [&](uint32_t value, uint32_t level, uint32_t morton_code)
+        {
+            REQUIRE(reference.get_voxel_at(morton_code) == value);
+            count++;
+        }
+    );
+    REQUIRE(count == reference_count);
+}
+
+TEST_CASE("Octree-Benchmark-Layout", "[.benchmark]")
+{
+    glm::ivec3 chunk_pos = GENERATE(glm::ivec3(0, 0, 0), glm::ivec3(3, 0, -2), glm::ivec3(-7, 0, 5));
+
+    Octree linear = generate_chunk_octree(chunk_pos, Octree::Layout::Linear);
+    Octree packed = generate_chunk_octree(chunk_pos, Octree::Layout::Packed);
+
+    std::vector<glm::ivec3> solid_blocks{};
+    linear.traverse(
+        [&](uint32_t value, uint32_t level, uint32_t morton_code)
+        {
+            solid_blocks.push_back(Octree::to_voxel_position(morton_code));
+        }
+    );
+
+    std::vector<uint32_t> random_morton_codes{};
+    std::mt19937 random(1234);
+    for (int i = 0; i < 100000; i++)
+    {
+        glm::ivec3 block_pos(random() % Chunk::k_grid_size.x, random() % Chunk::k_grid_size.y, random() % Chunk::k_grid_size.z);
+        random_morton_codes.push_back(Octree::to_morton_code(block_pos));
+    }
+
+    REQUIRE(read_neighbours(linear, solid_blocks) == read_neighbours(packed, solid_blocks));
+
+    BENCHMARK("Linear - Neighbours")
+    {
+        return read_neighbours(linear, solid_blocks);
+    };
+
+    BENCHMARK("Packed - Neighbours")
+    {
+        return read_neighbours(packed, solid_blocks);
+    };
+
+    BENCHMARK("Linear - Random")
+    {
+        uint64_t sum = 0;
+        for (uint32_t morton_code : random_morton_codes) sum += linear.get_voxel_at(morton_code);
+        return sum;
+    };
+
+    BENCHMARK("Packed - Random")
+    {
+        uint64_t sum = 0;
+        for (uint32_t morton_code : random_morton_codes) sum += packed.get_voxel_at(morton_code);
+        return sum;
+    };
+}
@@ -0,0 +1,80 @@
+#include <catch.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "util/profile_stats.hpp"
+
+using namespace explo;
+
+namespace
+{
+    /// Whether the estimate lies within the relative error of the LatencyHistogram quantiles.
+    bool is_estimate_of(double estimate, double expected)
+    {
+        return std::abs(estimate - expected) <= expected / LatencyHistogram::k_sub_bucket_count;
+    }
+}  // namespace
+
+TEST_CASE("profile_stats-Window")
+{
+    profile_stats stats(4);
+
+    for (uint64_t sample : {10, 50, 20, 30}) stats.push_sample(sample);
+    REQUIRE(stats.min_value() == 10);
+    REQUIRE(stats.max_value() == 50);
+    REQUIRE(stats.avg_value() == 27.5);
+    REQUIRE(stats.quantile_value(0.5) == 20);
+
+    // The spike and the minimum leave the window
+    for (uint64_t sample : {40, 40}) stats.push_sample(sample);
+    REQUIRE(stats.min_value() == 20);
+    REQUIRE(stats.max_value() == 40);
+    REQUIRE(stats.avg_value() == 32.5);
+    REQUIRE(stats.quantile_value(1.0) == 40);
+    REQUIRE(stats.last_value() == 40);
+    REQUIRE(stats.sample_count() == 6);
+}
+
+TEST_CASE("profile_stats-Quantiles")
+{
+    // A frame time spike every 100 frames is visible in the p99 but not in the average
+    profile_stats stats{};
+    for (int i = 0; i < 1000; i++) stats.push_elapsed_time(i % 100 == 99 ? 50'000'000 : 16'000'000);
+
+    REQUIRE(stats.avg_ms() < 17.0);
+    REQUIRE(is_estimate_of(stats.quantile_ms(0.5), 16.0));
+    REQUIRE(is_estimate_of(stats.quantile_ms(0.995), 50.0));
+    REQUIRE(stats.max_ms() == 50.0);
+}
+
+TEST_CASE("concurrent_profile_stats-Merge")
+{
+    size_t const k_thread_count = 4;
+    size_t const k_sample_count = 10000;
+
+    concurrent_profile_stats stats{};
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < k_thread_count; i++)
+    {
+        threads.emplace_back(
+            [&stats, i]()
+            {
+                for (size_t j = 0; j < k_sample_count; j++) stats.push_sample(1 + i * k_sample_count + j);
+            }
+        );
+    }
+    for (std::thread &thread : threads) thread.join();
+
+    size_t const k_total_count = k_thread_count * k_sample_count;
+    REQUIRE(stats.sample_count() == k_total_count);
+    REQUIRE(stats.min_ns() == 1);
+    REQUIRE(stats.max_ns() == k_total_count);
+    REQUIRE(stats.avg_ns() == (k_total_count + 1) / 2.0);
+    REQUIRE(is_estimate_of(double(stats.quantile_ns(0.5)), k_total_count / 2.0));
+
+    stats.reset();
+    REQUIRE(stats.sample_count() == 0);
+}
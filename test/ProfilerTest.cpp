@@ -0,0 +1,116 @@
+#include <atomic>
+#include <catch.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/Profiler.hpp"
+
+using namespace explo;
+
+namespace
+{
+    size_t count_occurrences(std::string const &string, std::string const &pattern)
+    {
+        size_t count = 0;
+        for (size_t position = string.find(pattern); position != std::string::npos; position = string.find(pattern, position + 1)) count++;
+        return count;
+    }
+}  // namespace
+
+TEST_CASE("Profiler-ChromeTrace")
+{
+    Profiler profiler{};
+    profiler.set_thread_name("Main");
+
+    uint64_t now = Profiler::get_now_ns();
+    profiler.record_zone("Frame", now, now + 16'000'000);
+
+    std::thread worker(
+        [&profiler, now]()
+        {
+            profiler.set_thread_name("Worker \"0\"");
+            for (int i = 0; i < 3; i++) profiler.record_zone("Job", now + i * 1000, now + i * 1000 + 500);
+        }
+    );
+    worker.join();
+
+    std::stringstream stream;
+    profiler.write_chrome_trace(stream);
+    std::string trace = stream.str();
+
+    // The zones of the joined thread are kept
+    REQUIRE(count_occurrences(trace, "\"ph\": \"M\"") == 2);
+    REQUIRE(count_occurrences(trace, "\"name\": \"Frame\", \"ph\": \"X\", \"pid\": 1, \"tid\": 0") == 1);
+    REQUIRE(count_occurrences(trace, "\"name\": \"Job\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1") == 3);
+    REQUIRE(count_occurrences(trace, "\"dur\": 16000.000") == 1);
+    REQUIRE(count_occurrences(trace, "\"name\": \"Worker \\\"0\\\"\"") == 1);
+}
+
+TEST_CASE("Profiler-ZoneBeforeCreation")
+{
+    // A zone begun before the profiler was created is clamped to its creation, not dropped
+    uint64_t begin_ns = Profiler::get_now_ns();
+    Profiler profiler{};
+    profiler.record_zone("Startup", begin_ns, Profiler::get_now_ns());
+
+    std::stringstream stream;
+    profiler.write_chrome_trace(stream);
+    std::string trace = stream.str();
+
+    REQUIRE(count_occurrences(trace, "\"name\": \"Startup\", \"ph\": \"X\"") == 1);
+    REQUIRE(count_occurrences(trace, "\"ts\": 0.000,") == 1);
+}
+
+TEST_CASE("Profiler-RingOverflow")
+{
+    // Only the latest zones are kept
+    Profiler profiler{};
+
+    uint64_t now = Profiler::get_now_ns();
+    for (size_t i = 0; i < Profiler::k_ring_capacity + 10; i++) profiler.record_zone(i < 10 ? "Old" : "New", now, now + 1);
+
+    std::stringstream stream;
+    profiler.write_chrome_trace(stream);
+    std::string trace = stream.str();
+
+    REQUIRE(count_occurrences(trace, "\"name\": \"Old\"") == 0);
+    // The oldest zone of a full ring could be in the middle of being overwritten, it's dropped
+    REQUIRE(count_occurrences(trace, "\"name\": \"New\"") == Profiler::k_ring_capacity - 1);
+}
+
+TEST_CASE("Profiler-ConcurrentDump")
+{
+    // Dumping while the threads record: every zone dumped must be complete
+    Profiler profiler{};
+    std::atomic<bool> stop = false;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; i++)
+    {
+        threads.emplace_back(
+            [&profiler, &stop]()
+            {
+                while (!stop)
+                {
+                    uint64_t begin_ns = Profiler::get_now_ns();
+                    profiler.record_zone("Zone", begin_ns, begin_ns + 1000);
+                }
+            }
+        );
+    }
+
+    for (int i = 0; i < 20; i++)
+    {
+        std::stringstream stream;
+        profiler.write_chrome_trace(stream);
+        std::string trace = stream.str();
+
+        REQUIRE(count_occurrences(trace, "\"ph\": \"X\"") == count_occurrences(trace, "\"dur\": 1.000"));
+    }
+
+    stop = true;
+    for (std::thread &thread : threads) thread.join();
+}
@@ -0,0 +1,105 @@
+#include <atomic>
+#include <catch.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <glm/glm.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "util/ShardedMap.hpp"
+#include "util/misc.hpp"
+
+using namespace explo;
+
+TEST_CASE("ShardedMap-Basic")
+{
+    ShardedMap<glm::ivec3, std::shared_ptr<int>, vec_hash> map{};
+
+    REQUIRE(map.emplace(glm::ivec3(1, 2, 3), std::make_shared<int>(1)).second);
+    REQUIRE(map.emplace(glm::ivec3(3, 2, 1), std::make_shared<int>(2)).second);
+
+    // Already mapped: the value in the map is returned
+    auto [value, inserted] = map.emplace(glm::ivec3(1, 2, 3), std::make_shared<int>(3));
+    REQUIRE(!inserted);
+    REQUIRE(*value == 1);
+
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.contains(glm::ivec3(3, 2, 1)));
+    REQUIRE(**map.find(glm::ivec3(3, 2, 1)) == 2);
+    REQUIRE(!map.find(glm::ivec3(0, 0, 0)));
+
+    size_t entry_count = 0;
+    map.for_each(
+        [&entry_count](glm::ivec3 const &, std::shared_ptr<int> const &)
+        {
+            entry_count++;
+        }
+    );
+    REQUIRE(entry_count == 2);
+
+    std::optional<std::shared_ptr<int>> extracted = map.extract(glm::ivec3(1, 2, 3));
+    REQUIRE(extracted);
+    REQUIRE(**extracted == 1);
+    REQUIRE(!map.extract(glm::ivec3(1, 2, 3)));
+    REQUIRE(map.size() == 1);
+}
+
+TEST_CASE("ShardedMap-ConcurrentAccess")
+{
+    // A writer loads and unloads a slab of positions, like the main thread, while readers look up their neighbours like the generation
+    // jobs. A value found must always be the one mapped to the position
+    int const k_extent = 16;
+
+    ShardedMap<glm::ivec3, std::shared_ptr<glm::ivec3>, vec_hash> map{};
+    std::atomic<bool> stop = false;
+    std::atomic<size_t> mismatch_count = 0;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                while (!stop)
+                {
+                    for (int x = 0; x < k_extent; x++)
+                    {
+                        for (int z = 0; z < k_extent; z++)
+                        {
+                            glm::ivec3 position(x, 0, z);
+                            std::optional<std::shared_ptr<glm::ivec3>> value = map.find(position);
+                            if (value && **value != position) mismatch_count++;
+                        }
+                    }
+                }
+            }
+        );
+    }
+
+    for (int round = 0; round < 200; round++)
+    {
+        for (int x = 0; x < k_extent; x++)
+        {
+            for (int z = 0; z < k_extent; z++)
+            {
+                glm::ivec3 position(x, 0, z);
+                if ((x + z + round) % 2 == 0) map.emplace(position, std::make_shared<glm::ivec3>(position));
+                else map.extract(position);
+            }
+        }
+    }
+
+    stop = true;
+    for (std::thread &reader : readers) reader.join();
+
+    REQUIRE(mismatch_count == 0);
+
+    size_t entry_count = 0;
+    map.for_each(
+        [&entry_count](glm::ivec3 const &, std::shared_ptr<glm::ivec3> const &)
+        {
+            entry_count++;
+        }
+    );
+    REQUIRE(entry_count == map.size());
+}
@@ -0,0 +1,245 @@
+#include <catch.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <glm/glm.hpp>
+
+#include "world/World.hpp"
+#include "world/surface/BlockySurfaceGenerator.hpp"
+#include "world/surface/GreedySurfaceGenerator.hpp"
+#include "world/volume/PerlinNoiseGenerator.hpp"
+
+using namespace explo;
+
+namespace
+{
+    glm::ivec3 const k_face_normals[]{{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
+
+    /// Counts the visible faces of the chunk, i.e. the quads written by BlockySurfaceGenerator (one per face).
+    size_t count_visible_faces(Chunk const &chunk, ChunkBorders const &borders)
+    {
+        size_t face_count = 0;
+        chunk.for_each_block(
+            [&](glm::ivec3 const &block_pos, uint8_t)
+            {
+                for (glm::ivec3 const &normal : k_face_normals)
+                {
+                    if (borders.get_block_type_at(chunk, block_pos + normal) == 0) face_count++;
+                }
+            }
+        );
+        return face_count;
+    }
+
+    /// Generates the neighbours of the chunk and copies their borders.
+    ChunkBorders generate_borders(World &world, VolumeGenerator &volume_generator, glm::ivec3 const &chunk_pos)
+    {
+        ChunkBorders borders{};
+        for (uint32_t face = 0; face < BlockFace_Count; face++)
+        {
+            Chunk neighbour(world, chunk_pos + ChunkBorders::get_face_normal(BlockFace(face)), VolumeStorageType::Dense);
+            volume_generator.generate_volume(neighbour);
+            borders.set_neighbour(BlockFace(face), neighbour);
+        }
+        return borders;
+    }
+}  // namespace
+
+TEST_CASE("GreedySurfaceGenerator-Slab")
+{
+    PerlinNoiseGenerator volume_generator{};
+    BlockySurfaceGenerator surface_generator{};
+    ThreadPool thread_pool(1);
+    World world(volume_generator, surface_generator, thread_pool);
+
+    Chunk chunk(world, glm::ivec3(0), VolumeStorageType::Dense);
+    chunk.fill_block_type(glm::ivec3(0, 10, 0), glm::ivec3(16, 12, 16), 3);
+    chunk.fill_block_type(glm::ivec3(0, 12, 0), glm::ivec3(16, 13, 16), 1);
+
+    std::vector<GreedySurfaceGenerator::Quad> quads;
+    GreedySurfaceGenerator::generate_quads(chunk, ChunkBorders{}, quads);
+
+    // Top and bottom are one quad each; every side is split by block type
+    REQUIRE(quads.size() == 10);
+}
+
+TEST_CASE("GreedySurfaceGenerator-CoversVisibleFaces")
+{
+    PerlinNoiseGenerator volume_generator{};
+    BlockySurfaceGenerator surface_generator{};
+    ThreadPool thread_pool(1);
+    World world(volume_generator, surface_generator, thread_pool);
+
+    glm::ivec3 chunk_pos = GENERATE(glm::ivec3(0, 0, 0), glm::ivec3(-3, 0, 5), glm::ivec3(7, 0, -2));
+
+    Chunk chunk(world, chunk_pos, VolumeStorageType::Dense);
+    volume_generator.generate_volume(chunk);
+
+    bool with_neighbours = GENERATE(false, true);
+    ChunkBorders borders = with_neighbours ? generate_borders(world, volume_generator, chunk_pos) : ChunkBorders{};
+
+    std::vector<GreedySurfaceGenerator::Quad> quads;
+    GreedySurfaceGenerator::generate_quads(chunk, borders, quads);
+
+    // Rasterize the quads back to faces: every face must be visible, of the quad block type, and covered once
+    std::vector<uint8_t> covered(size_t(Chunk::k_grid_size.x) * Chunk::k_grid_size.y * Chunk::k_grid_size.z * 6, 0);
+
+    size_t covered_count = 0;
+    for (GreedySurfaceGenerator::Quad const &quad : quads)
+    {
+        glm::ivec3 block_pos{};
+        for (block_pos.y = quad.m_from.y; block_pos.y < quad.m_to.y; block_pos.y++)
+        {
+            for (block_pos.z = quad.m_from.z; block_pos.z < quad.m_to.z; block_pos.z++)
+            {
+                for (block_pos.x = quad.m_from.x; block_pos.x < quad.m_to.x; block_pos.x++)
+                {
+                    REQUIRE(chunk.get_block_type_at(block_pos) == quad.m_block_type);
+                    REQUIRE(borders.get_block_type_at(chunk, block_pos + k_face_normals[quad.m_face]) == 0);
+
+                    size_t i = ((size_t(block_pos.y) * Chunk::k_grid_size.z + block_pos.z) * Chunk::k_grid_size.x + block_pos.x) * 6 + quad.m_face;
+                    REQUIRE(covered[i] == 0);
+                    covered[i] = 1;
+                    covered_count++;
+                }
+            }
+        }
+    }
+
+    size_t face_count = count_visible_faces(chunk, borders);
+    REQUIRE(covered_count == face_count);
+    REQUIRE(quads.size() < face_count);
+}
+
+TEST_CASE("SurfaceGenerator-NeighbourBorders")
+{
+    PerlinNoiseGenerator volume_generator{};
+    BlockySurfaceGenerator blocky_surface_generator{};
+    GreedySurfaceGenerator greedy_surface_generator{};
+    ThreadPool thread_pool(1);
+    World world(volume_generator, blocky_surface_generator, thread_pool);
+
+    glm::ivec3 chunk_pos(-3, 0, 5);
+
+    Chunk chunk(world, chunk_pos, VolumeStorageType::Dense);
+    volume_generator.generate_volume(chunk);
+
+    Chunk right_neighbour(world, chunk_pos + glm::ivec3(1, 0, 0), VolumeStorageType::Dense);
+    volume_generator.generate_volume(right_neighbour);
+
+    ChunkBorders borders{};
+    borders.set_neighbour(BlockFace_Right, right_neighbour);
+
+    REQUIRE(borders.has_neighbour(BlockFace_Right));
+    REQUIRE(!borders.has_neighbour(BlockFace_Left));
+    REQUIRE(borders.get_block_type_at(glm::ivec3(Chunk::k_grid_size.x, 3, 7)) == right_neighbour.get_block_type_at(glm::ivec3(0, 3, 7)));
+    REQUIRE(borders.get_block_type_at(glm::ivec3(Chunk::k_grid_size.x + 1, 3, 7)) == 0);
+    REQUIRE(borders.get_block_type_at(glm::ivec3(-1, 3, 7)) == 0);
+
+    auto generate_surface = [&](SurfaceGenerator &surface_generator, ChunkBorders const &borders)
+    {
+        Surface surface{};
+        SurfaceWriter surface_writer(surface);
+        surface_generator.generate(chunk, borders, surface_writer);
+        return surface;
+    };
+
+    // The wall facing the solid blocks of the neighbour is hidden
+    size_t face_count = count_visible_faces(chunk, borders);
+    REQUIRE(face_count < count_visible_faces(chunk, ChunkBorders{}));
+    REQUIRE(generate_surface(blocky_surface_generator, borders).m_vertices.size() == face_count * 4);
+
+    Surface greedy_surface = generate_surface(greedy_surface_generator, borders);
+    REQUIRE(greedy_surface.m_vertices.size() < generate_surface(greedy_surface_generator, ChunkBorders{}).m_vertices.size());
+
+    for (SurfaceVertex const &vertex : greedy_surface.m_vertices)
+    {
+        if (vertex.m_face != BlockFace_Right) continue;
+        glm::ivec3 position = vertex.get_position();
+        if (position.x != Chunk::k_grid_size.x) continue;
+
+        // Any right face on the chunk border must touch at least one air block of the neighbour
+        bool touches_air = false;
+        for (int dy = -1; dy <= 0; dy++)
+        {
+            for (int dz = -1; dz <= 0; dz++)
+            {
+                glm::ivec3 neighbour_pos(0, position.y + dy, position.z + dz);
+                if (!Chunk::test_chunk_block_position(neighbour_pos)) continue;
+                touches_air |= right_neighbour.get_block_type_at(neighbour_pos) == 0;
+            }
+        }
+        REQUIRE(touches_air);
+    }
+}
+
+TEST_CASE("SurfaceGenerator-PackedVertices")
+{
+    PerlinNoiseGenerator volume_generator{};
+    BlockySurfaceGenerator blocky_surface_generator{};
+    GreedySurfaceGenerator greedy_surface_generator{};
+    ThreadPool thread_pool(1);
+    World world(volume_generator, blocky_surface_generator, thread_pool);
+
+    Chunk chunk(world, glm::ivec3(-3, 0, 5), VolumeStorageType::Dense);
+    volume_generator.generate_volume(chunk);
+
+    bool greedy = GENERATE(false, true);
+    SurfaceGenerator &surface_generator = greedy ? static_cast<SurfaceGenerator &>(greedy_surface_generator) : blocky_surface_generator;
+
+    Surface surface{};
+    SurfaceWriter surface_writer(surface);
+    surface_generator.generate(chunk, ChunkBorders{}, surface_writer);
+
+    REQUIRE(!surface.m_vertices.empty());
+    REQUIRE(surface.m_indices.size() == surface.m_vertices.size() / 4 * 6);
+
+    for (SurfaceVertex const &vertex : surface.m_vertices)
+    {
+        glm::ivec3 position = vertex.get_position();
+        REQUIRE(glm::all(glm::greaterThanEqual(position, glm::ivec3(0))));
+        REQUIRE(glm::all(glm::lessThanEqual(position, Chunk::k_grid_size)));
+        REQUIRE(vertex.m_face < BlockFace_Count);
+        REQUIRE(vertex.m_block_type != 0);
+    }
+
+    // The instance places the chunk-relative vertices in world space
+    REQUIRE(surface.m_instances.size() == 1);
+    glm::vec4 origin = surface.m_instances[0].m_transform * glm::vec4(0, 0, 0, 1);
+    REQUIRE(glm::vec3(origin) == chunk.to_world_position(glm::vec3(0)));
+}
+
+TEST_CASE("GreedySurfaceGenerator-Benchmark", "[.benchmark]")
+{
+    PerlinNoiseGenerator volume_generator{};
+    BlockySurfaceGenerator blocky_surface_generator{};
+    GreedySurfaceGenerator greedy_surface_generator{};
+    ThreadPool thread_pool(1);
+    World world(volume_generator, blocky_surface_generator, thread_pool);
+
+    Chunk chunk(world, glm::ivec3(0), VolumeStorageType::Dense);
+    volume_generator.generate_volume(chunk);
+
+    auto generate_surface = [&](SurfaceGenerator &surface_generator)
+    {
+        Surface surface{};
+        SurfaceWriter surface_writer(surface);
+        surface_generator.generate(chunk, ChunkBorders{}, surface_writer);
+        return surface;
+    };
+
+    Surface blocky_surface = generate_surface(blocky_surface_generator);
+    Surface greedy_surface = generate_surface(greedy_surface_generator);
+    WARN("Blocky: " << blocky_surface.m_vertices.size() << " vertices, " << blocky_surface.m_indices.size() << " indices");
+    WARN("Greedy: " << greedy_surface.m_vertices.size() << " vertices, " << greedy_surface.m_indices.size() << " indices");
+
+    BENCHMARK("Blocky")
+    {
+        return generate_surface(blocky_surface_generator);
+    };
+
+    BENCHMARK("Greedy")
+    {
+        return generate_surface(greedy_surface_generator);
+    };
+}
@@ -0,0 +1,138 @@
+#include <catch.hpp>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+#include "util/SyncJobExecutor.hpp"
+
+using namespace explo;
+
+TEST_CASE("SyncJobExecutor-CountBudget")
+{
+    SyncJobExecutor executor{};
+
+    std::vector<int> run_order;
+    for (int i = 0; i < 10; i++)
+    {
+        executor.enqueue_job(
+            [&run_order, i]()
+            {
+                run_order.push_back(i);
+            }
+        );
+    }
+
+    REQUIRE(executor.process(SyncJobExecutor::Budget{.m_max_job_count = 4}) == 4);
+    REQUIRE(executor.get_job_count() == 6);
+
+    // The jobs carried over run before the ones enqueued afterwards
+    executor.enqueue_job(
+        [&run_order]()
+        {
+            run_order.push_back(10);
+        }
+    );
+
+    REQUIRE(executor.process(SyncJobExecutor::Budget{.m_max_job_count = 4}) == 4);
+    executor.process();
+    REQUIRE(executor.get_job_count() == 0);
+
+    REQUIRE(run_order == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+
+    REQUIRE(executor.get_queue_depth_stats().sample_count() == 3);
+    REQUIRE(executor.get_queue_depth_stats().max_value() == 10);
+    REQUIRE(executor.get_queue_depth_stats().last_value() == 3);
+}
+
+TEST_CASE("SyncJobExecutor-TimeBudget")
+{
+    SyncJobExecutor executor{};
+
+    size_t run_count = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        executor.enqueue_job(
+            [&run_count]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                run_count++;
+            }
+        );
+    }
+
+    // At least one job is run per call, even if it exceeds the budget
+    REQUIRE(executor.process(SyncJobExecutor::Budget{.m_max_time_ns = 1}) == 1);
+
+    size_t processed_count = executor.process(SyncJobExecutor::Budget{.m_max_time_ns = 5'000'000});
+    REQUIRE(processed_count >= 1);
+    REQUIRE(processed_count < 9);
+    REQUIRE(executor.get_process_stats().last_ms() >= 2.0);
+
+    // A job enqueued by a job is run by the next call
+    executor.enqueue_job(
+        [&executor, &run_count]()
+        {
+            executor.enqueue_job(
+                [&run_count]()
+                {
+                    run_count++;
+                }
+            );
+        }
+    );
+    executor.process();
+    REQUIRE(run_count == 10);
+    REQUIRE(executor.get_job_count() == 1);
+
+    executor.process();
+    REQUIRE(run_count == 11);
+}
+
+TEST_CASE("SyncJobExecutor-ManyProducers")
+{
+    size_t const k_producer_count = 8;
+    size_t const k_job_count = 50000;  // Per producer
+
+    SyncJobExecutor executor{};
+
+    // Only accessed by the consumer (the jobs run on it)
+    std::vector<size_t> next_sequence(k_producer_count, 0);
+    size_t out_of_order_count = 0;
+    size_t run_count = 0;
+
+    std::atomic<size_t> started_count = 0;
+
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < k_producer_count; producer++)
+    {
+        producers.emplace_back(
+            [&, producer]()
+            {
+                started_count++;
+                while (started_count.load() < k_producer_count) std::this_thread::yield();
+
+                for (size_t sequence = 0; sequence < k_job_count; sequence++)
+                {
+                    executor.enqueue_job(
+                        [&, producer, sequence]()
+                        {
+                            if (next_sequence[producer] != sequence) out_of_order_count++;
+                            next_sequence[producer] = sequence + 1;
+                            run_count++;
+                        }
+                    );
+                }
+            }
+        );
+    }
+
+    // Consume while the producers are pushing
+    while (run_count < k_producer_count * k_job_count) executor.process(SyncJobExecutor::Budget{.m_max_job_count = 1000});
+
+    for (std::thread &producer : producers) producer.join();
+
+    REQUIRE(out_of_order_count == 0);
+    REQUIRE(run_count == k_producer_count * k_job_count);
+    REQUIRE(executor.get_job_count() == 0);
+}
@@ -0,0 +1,167 @@
+#include <atomic>
+#include <catch.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/JobChain.hpp"
+#include "util/TaskGraph.hpp"
+
+using namespace explo;
+
+namespace
+{
+    void wait_for(std::atomic<size_t> const &counter, size_t value)
+    {
+        while (counter.load() < value) std::this_thread::yield();
+    }
+}  // namespace
+
+TEST_CASE("TaskGraph-Ordering")
+{
+    ThreadPool thread_pool(4);
+
+    for (int i = 0; i < 200; i++)
+    {
+        // A diamond (a -> b, c -> d) plus a fan-in of 8 independent tasks on e
+        std::atomic<size_t> sequence = 0;
+        std::atomic<size_t> a_at = 0, b_at = 0, c_at = 0, d_at = 0, e_at = 0;
+        std::atomic<size_t> fan_in_at[8]{};
+
+        auto record = [&sequence](std::atomic<size_t> &at)
+        {
+            return [&sequence, &at]()
+            {
+                at = ++sequence;
+            };
+        };
+
+        TaskGraph task_graph{};
+        std::shared_ptr<Task> a = task_graph.add(record(a_at));
+        std::shared_ptr<Task> b = task_graph.add(record(b_at), {a});
+        std::shared_ptr<Task> c = task_graph.add(record(c_at), {a});
+        task_graph.add(record(d_at), {b, c});
+
+        std::vector<std::shared_ptr<Task>> fan_in;
+        for (std::atomic<size_t> &at : fan_in_at) fan_in.push_back(task_graph.add(record(at)));
+        task_graph.add(record(e_at), fan_in);
+
+        task_graph.dispatch(thread_pool);
+        wait_for(sequence, 13);
+
+        REQUIRE(a_at < b_at);
+        REQUIRE(a_at < c_at);
+        REQUIRE(b_at < d_at);
+        REQUIRE(c_at < d_at);
+        for (std::atomic<size_t> &at : fan_in_at) REQUIRE(at < e_at);
+    }
+}
+
+TEST_CASE("TaskGraph-CrossGraphDependencies")
+{
+    ThreadPool thread_pool(2);
+
+    std::atomic<size_t> run_count = 0;
+    auto count = [&run_count]()
+    {
+        run_count++;
+    };
+
+    // A task already done doesn't hold its successors
+    TaskGraph first_graph{};
+    std::shared_ptr<Task> first = first_graph.add(count);
+    first_graph.dispatch(thread_pool);
+    wait_for(run_count, 1);
+    while (!first->is_done()) std::this_thread::yield();
+
+    // A cancelled task doesn't run but still releases the tasks of the other graphs
+    auto cancelled_token = std::make_shared<JobToken>();
+    cancelled_token->cancel();
+
+    TaskGraph cancelled_graph(cancelled_token);
+    std::shared_ptr<Task> cancelled = cancelled_graph.add(count);
+
+    TaskGraph last_graph{};
+    std::shared_ptr<Task> last = last_graph.add(count, {first, cancelled});
+
+    last_graph.dispatch(thread_pool);
+    REQUIRE(!last->is_done());
+
+    cancelled_graph.dispatch(thread_pool);
+    while (!last->is_done()) std::this_thread::yield();
+
+    REQUIRE(cancelled->is_done());
+    REQUIRE(run_count == 2);
+}
+
+TEST_CASE("TaskGraph-InlineContinuation")
+{
+    ThreadPool thread_pool(4);
+
+    std::thread::id first_thread_id, second_thread_id;
+    std::atomic<size_t> run_count = 0;
+
+    TaskGraph task_graph{};
+    std::shared_ptr<Task> first = task_graph.add(
+        [&]()
+        {
+            first_thread_id = std::this_thread::get_id();
+            run_count++;
+        }
+    );
+    task_graph.add(
+        [&]()
+        {
+            second_thread_id = std::this_thread::get_id();
+            run_count++;
+        },
+        {first}
+    );
+    task_graph.dispatch(thread_pool);
+    wait_for(run_count, 2);
+
+    // The only successor runs on the worker that finished its predecessor, without going back to the queues
+    REQUIRE(first_thread_id == second_thread_id);
+}
+
+TEST_CASE("TaskGraph-Benchmark", "[.benchmark]")
+{
+    size_t const k_chain_count = 1000;
+    size_t const k_stage_count = GENERATE(4, 32);
+
+    ThreadPool thread_pool(4);
+    std::atomic<size_t> run_count = 0;
+
+    auto stage = [&run_count]()
+    {
+        run_count++;
+    };
+
+    BENCHMARK("JobChain; Stages: " + std::to_string(k_stage_count))
+    {
+        run_count = 0;
+        for (size_t i = 0; i < k_chain_count; i++)
+        {
+            JobChain job_chain{};
+            for (size_t j = 0; j < k_stage_count; j++) job_chain.then(stage);
+            job_chain.dispatch(thread_pool);
+        }
+        wait_for(run_count, k_chain_count * k_stage_count);
+    };
+
+    BENCHMARK("TaskGraph; Stages: " + std::to_string(k_stage_count))
+    {
+        run_count = 0;
+        for (size_t i = 0; i < k_chain_count; i++)
+        {
+            TaskGraph task_graph{};
+            std::shared_ptr<Task> previous = task_graph.add(stage);
+            for (size_t j = 1; j < k_stage_count; j++) previous = task_graph.add(stage, {previous});
+            task_graph.dispatch(thread_pool);
+        }
+        wait_for(run_count, k_chain_count * k_stage_count);
+    };
+}
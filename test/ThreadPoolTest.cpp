@@ -0,0 +1,169 @@
+#include <atomic>
+#include <catch.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/ThreadPool.hpp"
+#include "util/WorkStealingDeque.hpp"
+
+using namespace explo;
+
+namespace
+{
+    void wait_for(std::atomic<size_t> const &counter, size_t value)
+    {
+        while (counter.load() < value) std::this_thread::yield();
+    }
+
+    /// Enqueues job_count jobs from the calling thread, each of them enqueueing sub_job_count jobs from the worker, and waits for
+    /// all of them to run.
+    void run_jobs(ThreadPool &thread_pool, size_t job_count, size_t sub_job_count)
+    {
+        std::atomic<size_t> run_count = 0;
+        for (size_t i = 0; i < job_count; i++)
+        {
+            thread_pool.enqueue_job(
+                [&thread_pool, &run_count, sub_job_count]()
+                {
+                    for (size_t j = 0; j < sub_job_count; j++)
+                    {
+                        thread_pool.enqueue_job(
+                            [&run_count]()
+                            {
+                                run_count++;
+                            }
+                        );
+                    }
+                    run_count++;
+                }
+            );
+        }
+        wait_for(run_count, job_count * (sub_job_count + 1));
+    }
+}  // namespace
+
+TEST_CASE("WorkStealingDeque-ConcurrentSteal")
+{
+    size_t const k_item_count = 200000;
+    size_t const k_thief_count = 4;
+
+    WorkStealingDeque<uint32_t> deque(16);  // Small to exercise the growth while stealing
+
+    std::vector<std::atomic<uint8_t>> taken(k_item_count + 1);
+    std::atomic<size_t> taken_count = 0;
+
+    // Catch assertions aren't thread safe: only count from the threads
+    auto take = [&](uint32_t item)
+    {
+        taken[item]++;
+        taken_count++;
+    };
+
+    std::vector<std::thread> thieves;
+    for (size_t i = 0; i < k_thief_count; i++)
+    {
+        thieves.emplace_back(
+            [&]()
+            {
+                while (taken_count.load() < k_item_count)
+                {
+                    if (uint32_t item = deque.steal()) take(item);
+                }
+            }
+        );
+    }
+
+    // The owner pushes all of the items, popping some of them along the way
+    for (uint32_t item = 1; item <= k_item_count; item++)
+    {
+        deque.push(item);
+        if (item % 3 == 0)
+        {
+            if (uint32_t popped = deque.pop()) take(popped);
+        }
+    }
+    while (uint32_t popped = deque.pop()) take(popped);
+
+    for (std::thread &thief : thieves) thief.join();
+
+    REQUIRE(taken_count == k_item_count);
+    for (uint32_t item = 1; item <= k_item_count; item++) REQUIRE(taken[item] == 1);
+}
+
+TEST_CASE("ThreadPool-RunsEveryJob")
+{
+    size_t thread_count = GENERATE(1, 3, 8);
+    ThreadPool thread_pool(thread_count);
+
+    run_jobs(thread_pool, 1000, 10);
+
+    thread_pool.drain();
+    REQUIRE(thread_pool.get_job_count() == 0);
+}
+
+TEST_CASE("ThreadPool-PrioritiesAndCancellation")
+{
+    ThreadPool thread_pool(1);
+
+    // Keep the only worker busy while the prioritized jobs are enqueued
+    std::atomic<bool> gate_open = false;
+    thread_pool.enqueue_job(
+        [&gate_open]()
+        {
+            while (!gate_open.load()) std::this_thread::yield();
+        }
+    );
+    while (!thread_pool.is_thread_working(0)) std::this_thread::yield();
+
+    std::vector<int> run_order;  // Only written by the worker
+    std::atomic<size_t> run_count = 0;
+
+    std::vector<std::shared_ptr<JobToken>> tokens;
+    for (int i = 0; i < 5; i++)
+    {
+        tokens.push_back(std::make_shared<JobToken>(float(i)));
+        thread_pool.enqueue_job(
+            [&run_order, &run_count, i]()
+            {
+                run_order.push_back(i);
+                run_count++;
+            },
+            tokens.back()
+        );
+    }
+
+    // Reverse the order of the last three, and cancel the second
+    tokens[2]->set_priority(10.0f);
+    tokens[4]->set_priority(-1.0f);
+    tokens[1]->cancel();
+    thread_pool.update_priorities();
+
+    REQUIRE(thread_pool.get_job_count() == 4);
+
+    gate_open = true;
+    wait_for(run_count, 4);
+
+    REQUIRE(run_order == std::vector<int>{4, 0, 3, 2});
+}
+
+TEST_CASE("ThreadPool-Benchmark", "[.benchmark]")
+{
+    size_t thread_count = GENERATE(1, 2, 4, 8, 16, 32, 64);
+    ThreadPool thread_pool(thread_count);
+
+    // The jobs are enqueued from the main thread, like the chunk loads
+    BENCHMARK("Flat; Threads: " + std::to_string(thread_count))
+    {
+        run_jobs(thread_pool, 10000, 0);
+    };
+
+    // The jobs are enqueued by the workers, like the chunk generation stages
+    BENCHMARK("Nested; Threads: " + std::to_string(thread_count))
+    {
+        run_jobs(thread_pool, 100, 100);
+    };
+}
@@ -0,0 +1,178 @@
+#include <catch.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <random>
+
+#include "world/World.hpp"
+#include "world/surface/BlockySurfaceGenerator.hpp"
+#include "world/volume/DenseVolumeStorage.hpp"
+#include "world/volume/OctreeVolumeStorage.hpp"
+#include "world/volume/PaletteVolumeStorage.hpp"
+#include "world/volume/PerlinNoiseGenerator.hpp"
+
+using namespace explo;
+
+TEST_CASE("VolumeStorage-DenseMatchesOctree")
+{
+    DenseVolumeStorage dense(Chunk::k_grid_size);
+    OctreeVolumeStorage octree(Chunk::k_grid_size);
+
+    std::mt19937 random(1234);
+    for (int i = 0; i < 200; i++)
+    {
+        glm::ivec3 from(random() % 16, random() % 256, random() % 16);
+        glm::ivec3 to = glm::min(from + glm::ivec3(random() % 8 + 1, random() % 64 + 1, random() % 8 + 1), Chunk::k_grid_size);
+        uint8_t block_type = random() % 4;
+
+        dense.fill_block_type(from, to, block_type);
+        octree.fill_block_type(from, to, block_type);
+
+        glm::ivec3 block_pos(random() % 16, random() % 256, random() % 16);
+        dense.set_block_type_at(block_pos, block_type + 1);
+        octree.set_block_type_at(block_pos, block_type + 1);
+    }
+
+    glm::ivec3 block_pos{};
+    for (block_pos.x = 0; block_pos.x < Chunk::k_grid_size.x; block_pos.x++)
+    {
+        for (block_pos.y = 0; block_pos.y < Chunk::k_grid_size.y; block_pos.y++)
+        {
+            for (block_pos.z = 0; block_pos.z < Chunk::k_grid_size.z; block_pos.z++)
+                REQUIRE(dense.get_block_type_at(block_pos) == octree.get_block_type_at(block_pos));
+        }
+    }
+
+    size_t dense_count = 0, octree_count = 0;
+    dense.for_each_block(
+        [&](glm::ivec3 const &block_pos, uint8_t block_type)
+        {
+            REQUIRE(octree.get_block_type_at(block_pos) == block_type);
+            dense_count++;
+        }
+    );
+    octree.for_each_block(
+        [&](glm::ivec3 const &block_pos, uint8_t block_type)
+        {
+            REQUIRE(dense.get_block_type_at(block_pos) == block_type);
+            octree_count++;
+        }
+    );
+    REQUIRE(dense_count == octree_count);
+}
+
+TEST_CASE("VolumeStorage-DenseMatchesPalette")
+{
+    DenseVolumeStorage dense(Chunk::k_grid_size);
+    PaletteVolumeStorage palette(Chunk::k_grid_size);
+
+    // Enough block types to reach 8-bit indices in some sections
+    std::mt19937 random(5678);
+    for (int i = 0; i < 400; i++)
+    {
+        glm::ivec3 from(random() % 16, random() % 256, random() % 16);
+        glm::ivec3 to = glm::min(from + glm::ivec3(random() % 16 + 1, random() % 64 + 1, random() % 16 + 1), Chunk::k_grid_size);
+        uint8_t block_type = random() % 4;
+
+        dense.fill_block_type(from, to, block_type);
+        palette.fill_block_type(from, to, block_type);
+
+        glm::ivec3 block_pos(random() % 16, random() % 32, random() % 16);
+        dense.set_block_type_at(block_pos, random() % 64);
+        palette.set_block_type_at(block_pos, dense.get_block_type_at(block_pos));
+    }
+
+    auto check = [&]()
+    {
+        glm::ivec3 block_pos{};
+        for (block_pos.x = 0; block_pos.x < Chunk::k_grid_size.x; block_pos.x++)
+        {
+            for (block_pos.y = 0; block_pos.y < Chunk::k_grid_size.y; block_pos.y++)
+            {
+                for (block_pos.z = 0; block_pos.z < Chunk::k_grid_size.z; block_pos.z++)
+                    REQUIRE(dense.get_block_type_at(block_pos) == palette.get_block_type_at(block_pos));
+            }
+        }
+
+        size_t dense_count = 0, palette_count = 0;
+        dense.for_each_block([&](glm::ivec3 const &, uint8_t) { dense_count++; });
+        palette.for_each_block(
+            [&](glm::ivec3 const &block_pos, uint8_t block_type)
+            {
+                REQUIRE(dense.get_block_type_at(block_pos) == block_type);
+                palette_count++;
+            }
+        );
+        REQUIRE(dense_count == palette_count);
+    };
+
+    check();
+
+    size_t byte_size = palette.get_byte_size();
+    palette.optimize();
+    REQUIRE(palette.get_byte_size() <= byte_size);
+
+    check();
+
+    // After optimization every section uses the fewest bits able to index its palette
+    for (PaletteVolumeStorage::Section const &section : palette.get_sections())
+    {
+        REQUIRE(section.m_indices.size() == section.m_bits * PaletteVolumeStorage::k_section_block_count / 64);
+        if (section.m_palette.size() == 1) REQUIRE(section.m_bits == 0);
+        else REQUIRE(section.m_palette.size() > (section.m_bits == 1 ? 1u : 1u << (section.m_bits / 2)));
+    }
+}
+
+TEST_CASE("VolumeStorage-PaletteSectionBits")
+{
+    PaletteVolumeStorage::Section section{};
+    REQUIRE(section.m_bits == 0);
+
+    uint32_t expected_bits[]{1, 2, 2, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 8};
+    for (uint32_t block_type = 1; block_type <= 16; block_type++)
+    {
+        section.set_block_type_at(block_type * 97, block_type);
+        REQUIRE(section.m_bits == expected_bits[block_type - 1]);
+    }
+
+    for (uint32_t block_type = 1; block_type <= 16; block_type++) REQUIRE(section.get_block_type_at(block_type * 97) == block_type);
+    REQUIRE(section.get_block_type_at(0) == 0);
+
+    // Overwrite all but one block type: the palette shrinks on optimization
+    for (uint32_t block_type = 2; block_type <= 16; block_type++) section.set_block_type_at(block_type * 97, 0);
+    section.optimize();
+    REQUIRE(section.m_palette.size() == 2);
+    REQUIRE(section.m_bits == 1);
+    REQUIRE(section.get_block_type_at(97) == 1);
+
+    section.fill(3);
+    REQUIRE(section.m_bits == 0);
+    REQUIRE(section.get_block_type_at(97) == 3);
+}
+
+TEST_CASE("VolumeStorage-ChunkConversion")
+{
+    PerlinNoiseGenerator volume_generator{};
+    BlockySurfaceGenerator surface_generator{};
+    ThreadPool thread_pool(1);
+    World world(volume_generator, surface_generator, thread_pool);
+
+    Chunk reference(world, glm::ivec3(2, 0, -3), VolumeStorageType::Octree);
+    volume_generator.generate_volume(reference);
+
+    Chunk chunk(world, glm::ivec3(2, 0, -3), VolumeStorageType::Dense);
+    volume_generator.generate_volume(chunk);
+
+    VolumeStorageType volume_storage_type = GENERATE(VolumeStorageType::Dense, VolumeStorageType::Octree, VolumeStorageType::Palette);
+    chunk.set_volume_storage_type(volume_storage_type);
+    REQUIRE(chunk.get_volume_storage_type() == volume_storage_type);
+
+    glm::ivec3 block_pos{};
+    for (block_pos.x = -1; block_pos.x <= Chunk::k_grid_size.x; block_pos.x++)
+    {
+        for (block_pos.y = -1; block_pos.y <= Chunk::k_grid_size.y; block_pos.y++)
+        {
+            for (block_pos.z = -1; block_pos.z <= Chunk::k_grid_size.z; block_pos.z++)
+                REQUIRE(chunk.get_block_type_at(block_pos) == reference.get_block_type_at(block_pos));  // Outside is air
+        }
+    }
+}
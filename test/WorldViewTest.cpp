@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <atomic>
+#include <catch.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <chrono>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/JobToken.hpp"
+#include "util/ThreadPool.hpp"
+#include "video/RecordingRenderSink.hpp"
+#include "world/DeltaChunkIterator.hpp"
+#include "world/Entity.hpp"
+#include "world/WorldView.hpp"
+#include "world/surface/BlockySurfaceGenerator.hpp"
+#include "world/volume/PerlinNoiseGenerator.hpp"
+
+using namespace explo;
+
+namespace
+{
+    /// The chunks loaded on spawn, in the order DeltaChunkIterator gives them.
+    std::vector<glm::ivec3> get_spawn_chunks(glm::ivec3 const &render_distance)
+    {
+        std::vector<glm::ivec3> chunk_positions;
+        DeltaChunkIterator iterator(
+            glm::ivec3(render_distance * 2 + 1),
+            glm::ivec3(0),
+            render_distance,
+            [&](glm::ivec3 const &chunk_pos)
+            {
+                chunk_positions.push_back(chunk_pos);
+            }
+        );
+        iterator.iterate();
+        return chunk_positions;
+    }
+
+    void spin_for(std::chrono::microseconds duration)
+    {
+        auto until = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < until) {}
+    }
+}  // namespace
+
+TEST_CASE("WorldView-LoadOrder")
+{
+    glm::ivec3 const k_render_distance(4, 1, 4);
+
+    std::vector<glm::ivec3> chunk_positions = get_spawn_chunks(k_render_distance);
+    WorldView::sort_by_load_order(chunk_positions, glm::ivec3(0), glm::vec3(0));
+
+    // Shells of increasing distance, starting from the world view position
+    REQUIRE(chunk_positions.front() == glm::ivec3(0));
+    for (size_t i = 1; i < chunk_positions.size(); i++)
+    {
+        glm::ivec3 previous = chunk_positions[i - 1], current = chunk_positions[i];
+        REQUIRE(glm::dot(previous, previous) <= glm::dot(current, current));
+    }
+
+    // Looking along +x, the chunk ahead comes before the one behind at the same distance
+    WorldView::sort_by_load_order(chunk_positions, glm::ivec3(0), glm::vec3(2, 0, 0));
+
+    auto get_index = [&](glm::ivec3 const &chunk_pos)
+    {
+        return std::find(chunk_positions.begin(), chunk_positions.end(), chunk_pos) - chunk_positions.begin();
+    };
+    REQUIRE(chunk_positions.front() == glm::ivec3(0));
+    REQUIRE(get_index(glm::ivec3(1, 0, 0)) < get_index(glm::ivec3(0, 0, 1)));
+    REQUIRE(get_index(glm::ivec3(0, 0, 1)) < get_index(glm::ivec3(-1, 0, 0)));
+}
+
+TEST_CASE("WorldView-HeadlessStreaming")
+{
+    // Streams the world without a renderer: walking a chunk along +x, the world view must end up fully uploaded around the new position
+    // and the chunks left behind must be destroyed
+    glm::ivec3 const k_render_distance(2, 0, 2);
+    size_t const k_world_view_size = 5 * 5;
+
+    RecordingRenderSink render_sink{};
+    PerlinNoiseGenerator volume_generator{};
+    BlockySurfaceGenerator surface_generator{};
+    ThreadPool thread_pool(2);
+
+    auto wait_for_world_view = [&]()
+    {
+        auto until = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        while (render_sink.get_resident_chunk_count() < k_world_view_size && std::chrono::steady_clock::now() < until)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return render_sink.get_resident_chunk_count();
+    };
+
+    std::shared_ptr<World> world = std::make_shared<World>(volume_generator, surface_generator, thread_pool);
+    Entity entity(*world, render_sink, glm::vec3(8, 10, 8));
+
+    entity.recreate_world_view(k_render_distance);
+    REQUIRE(wait_for_world_view() == k_world_view_size);
+    REQUIRE(render_sink.is_chunk_resident(glm::ivec3(-2, 0, 0)));
+
+    size_t destroy_count = render_sink.get_counters().m_destroy_count;
+    entity.set_position(entity.get_position() + glm::vec3(Chunk::k_world_size.x, 0, 0));
+    REQUIRE(wait_for_world_view() == k_world_view_size);
+    REQUIRE(render_sink.is_chunk_resident(glm::ivec3(3, 0, 0)));
+    REQUIRE(!render_sink.is_chunk_resident(glm::ivec3(-2, 0, 0)));
+    REQUIRE(render_sink.get_counters().m_destroy_count - destroy_count == 5);  // The slab left behind
+
+    // Every chunk went through the pipeline once
+    ChunkMetrics const &chunk_metrics = world->get_chunk_metrics();
+    REQUIRE(chunk_metrics.get_stage_latency(ChunkStage_Uploaded).get_count() == k_world_view_size + 5);
+    REQUIRE(chunk_metrics.get_stage_latency(ChunkStage_Destroyed).get_count() == 5);
+    REQUIRE(chunk_metrics.get_stage_latency(ChunkStage_SurfaceGenerated).get_count() == k_world_view_size + 5);
+    REQUIRE(chunk_metrics.get_counters().m_cancelled_count == 0);  // The chunks left behind were generated
+
+    thread_pool.drain();
+}
+
+TEST_CASE("WorldView-TimeToFirstNearbyChunk", "[.benchmark]")
+{
+    // Simulates the spawn with a render distance of 20: a loader thread (the main thread) loads the chunks one after the other (a chunk
+    // allocation each) while the workers generate them by priority. Measures the time until the 3x1x3 chunks around the player are
+    // generated, the loading then stops
+    glm::ivec3 const k_render_distance(20, 0, 20);
+    bool const sorted = GENERATE(false, true);
+
+    ThreadPool thread_pool(4);
+
+    std::vector<glm::ivec3> chunk_positions = get_spawn_chunks(k_render_distance);
+    if (sorted) WorldView::sort_by_load_order(chunk_positions, glm::ivec3(0), glm::vec3(0));
+
+    BENCHMARK(std::string(sorted ? "Load order" : "DeltaChunkIterator order") + "; Render distance: 20")
+    {
+        std::atomic<size_t> nearby_generated_count = 0;
+        std::atomic<bool> stop_loading = false;
+        std::vector<std::shared_ptr<JobToken>> tokens;
+
+        std::thread loader(
+            [&]()
+            {
+                std::vector<std::unique_ptr<uint8_t[]>> chunk_storages;
+                for (glm::ivec3 const &chunk_pos : chunk_positions)
+                {
+                    if (stop_loading) break;
+
+                    std::shared_ptr<JobToken> token = std::make_shared<JobToken>();
+                    token->set_priority(World::get_chunk_priority(glm::ivec3(0), glm::vec3(0), chunk_pos));
+                    tokens.push_back(token);
+
+                    chunk_storages.push_back(std::make_unique<uint8_t[]>(64 * 1024));  // The chunk dense storage
+
+                    bool nearby = glm::abs(chunk_pos.x) <= 1 && glm::abs(chunk_pos.z) <= 1;
+                    thread_pool.enqueue_job(
+                        [&nearby_generated_count, nearby]()
+                        {
+                            spin_for(std::chrono::microseconds(50));
+                            if (nearby) nearby_generated_count++;
+                        },
+                        token
+                    );
+                }
+            }
+        );
+
+        while (nearby_generated_count < 9) std::this_thread::yield();
+
+        stop_loading = true;
+        loader.join();
+
+        for (std::shared_ptr<JobToken> const &token : tokens) token->cancel();
+        thread_pool.drain();
+    };
+}